@@ -2,6 +2,7 @@
 #include <filesystem>
 #include <Utils/ErrorManager.h>
 #include <Utils/String.h>
+#include <Module/ModuleInterface.h>
 
 std::vector<std::string> g_importPaths;
 
@@ -25,14 +26,17 @@ void ImportsHandler::addImport(std::string module) {
 	}
 
 	// Adding import
-	const std::vector<std::string>& currImportPaths = getCurrFileImportPaths();
-	std::string importPath = findFullImportPath(module, currImportPaths);
-	if (importPath != "") {
-		if (fileName == "*") {
-			handleAllImport(importPath);
-		} else {
-			handleSingleImport(importPath);
-		}
+	std::string importPath = findImportPath(g_currFilePath, module);
+	if (importPath == "") {
+		ErrorManager::lexerError(
+			ErrorID::E1001_NO_SUCH_MODULE_FOUND,
+			-1,
+			module
+		);
+	} else if (fileName == "*") {
+		handleAllImport(importPath);
+	} else {
+		handleSingleImport(importPath);
 	}
 }
 
@@ -50,41 +54,57 @@ void ImportsHandler::handleAllImport(const std::string& importPath) {
 			&& f.path().extension() == ".core"
 			&& f.path().string() != g_currFilePath) {
 			m_result.push_back(f.path().string());
+		} else if (f.path().has_extension() && f.path().extension() == ".coreif") {
+			// A module shipped without the source
+			std::string modulePath = f.path().string();
+			modulePath.erase(modulePath.size() - 2);
+
+			if (!std::filesystem::exists(modulePath) && ModuleInterface::exists(modulePath)) {
+				m_result.push_back(modulePath);
+			}
 		}
 	}
 }
 
-std::string ImportsHandler::findFullImportPath(const std::string& module, const std::vector<std::string>& currImportPaths) {
-	// First priority: looking for the file in relative directories (current, ../, ...)
-	for (auto& path : currImportPaths) {
-		std::filesystem::path p(path + module);
-		if (std::filesystem::exists(p) && p.string() != g_currFilePath) {
-			return path + module;
+std::string ImportsHandler::findImportPath(const std::string& importerPath, const std::string& importName) {
+	for (auto& path : getImportDirectories(importerPath)) {
+		if (ModuleInterface::exists(path + importName) && path + importName != importerPath) {
+			return path + importName;
 		}
 	}
 
-	// Looking for the imported file in project's import paths
-	for (auto& path : g_importPaths) {
-		std::filesystem::path p(path + module);
-		if (std::filesystem::exists(p) && p.string() != g_currFilePath) {
-			return path + module;
-		}
+	// A module that has no import name is referred to by its full path (see getImportName)
+	if (std::filesystem::path(importName).is_absolute() && ModuleInterface::exists(importName)) {
+		return importName;
 	}
 
-	ErrorManager::lexerError(
-		ErrorID::E1001_NO_SUCH_MODULE_FOUND, 
-		-1, 
-		module
-	);
-
 	return "";
 }
 
-const std::vector<std::string>& ImportsHandler::getCurrFileImportPaths() {
+std::string ImportsHandler::getImportName(const std::string& importerPath, const std::string& modulePath) {
+	// The shortest name, since the parent directories are import directories too (core/lang.core rather than repos/lib/core/lang.core)
+	std::string result = modulePath;
+	for (auto& path : getImportDirectories(importerPath)) {
+		if (modulePath.starts_with(path) && modulePath.size() - path.size() < result.size()
+			&& findImportPath(importerPath, modulePath.substr(path.size())) == modulePath) {
+			result = modulePath.substr(path.size());
+		}
+	}
+
+	return result;
+}
+
+const std::vector<std::string>& ImportsHandler::getImportDirectories(const std::string& filePath) {
+	static std::string cachedFilePath;
 	static std::vector<std::string> result;
+	if (cachedFilePath == filePath && !result.empty()) {
+		return result;
+	}
+
+	cachedFilePath = filePath;
 	result.clear();
 	
-	std::vector<std::string> currPath = split(g_currFilePath, '/');
+	std::vector<std::string> currPath = split(filePath, '/');
 	result.resize(currPath.size());
 	for (size_t i = result.size(); i > 0; i--) {
 		for (size_t j = 0; j < i; j++) {
@@ -93,5 +113,7 @@ const std::vector<std::string>& ImportsHandler::getCurrFileImportPaths() {
 		}
 	}
 
+	// First priority: the relative directories, then the project's import paths
+	result.insert(result.end(), g_importPaths.begin(), g_importPaths.end());
 	return result;
 }
\ No newline at end of file
@@ -21,14 +21,18 @@ public:
 	// Get the resulting imported files list, clears stored list
 	std::vector<std::string> getImportedFiles();
 
+	// Searching for the path of the module imported by the file -importerPath- (-importName- is like core/lang.core), "" if not found
+	static std::string findImportPath(const std::string& importerPath, const std::string& importName);
+
+	// The name the file -importerPath- imports the module by (its path relative to an import directory),
+	// the module's path if the module cannot be imported by a relative name
+	static std::string getImportName(const std::string& importerPath, const std::string& modulePath);
+
 private:
 	// Adding an import path(-s) to the list
 	void handleSingleImport(const std::string& importPath);
 	void handleAllImport(const std::string& importPath);
 
-	// Searching for the path of the -module-'s import
-	std::string findFullImportPath(const std::string& module, const std::vector<std::string>& currImportPaths);
-
-	// Slicing current file's directory into { current, ../, ../../, etc }
-	static const std::vector<std::string>& getCurrFileImportPaths();
+	// The directories the file's imports are searched in: { current, ../, ../../, etc } and then the project's import paths
+	static const std::vector<std::string>& getImportDirectories(const std::string& filePath);
 };
\ No newline at end of file
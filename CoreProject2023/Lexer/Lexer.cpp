@@ -1,10 +1,15 @@
 #include "Lexer.h"
-#include <map>
 #include <functional>
+#include <string_view>
 #include <Utils/String.h>
+#include <Utils/Statistics.h>
 #include "ImportsHandler.h"
 
-std::vector<std::string> KEY_WORDS{
+STATISTIC(NumTokens, "lexer", "tokens produced");
+STATISTIC(NumTokenizedModules, "lexer", "modules tokenized");
+
+// The order must be the same as in TokenType
+constexpr std::string_view KEY_WORDS[] = {
 	"import", "use",
 	"def", "native", "return",
 	"class", "interface", "struct", "enum", "union", "tuple",
@@ -21,89 +26,115 @@ std::vector<std::string> KEY_WORDS{
 	"u8", "u16", "u32", "u64", "f32", "f64", "func"
 };
 
-std::map<std::string, TokenType> OPERATORS = {
-	{ "=", TokenType::EQ },
-	{ "+=", TokenType::PLUS_EQ },
-	{ "-=", TokenType::MINUS_EQ },
-	{ "*=", TokenType::STAR_EQ },
-	{ "/=", TokenType::SLASH_EQ },
-	{ "//=", TokenType::DSLASH_EQ },
-	{ "%=", TokenType::PERCENT_EQ },
-	{ "**=", TokenType::POWER_EQ },
-	{ "&=", TokenType::AND_EQ },
-	{ "|=", TokenType::OR_EQ },
-	{ "^=", TokenType::XOR_EQ },
-	{ "<<=", TokenType::LSHIFT_EQ },
-	{ ">>=", TokenType::RSHIFT_EQ },
-	{ "++", TokenType::INCREMENT },
-	{ "--", TokenType::DECREMENT },
-	{ "+", TokenType::PLUS },
-	{ "-", TokenType::MINUS },
-	{ "*", TokenType::STAR },
-	{ "/", TokenType::SLASH },
-	{ "//", TokenType::DSLASH },
-	{ "%", TokenType::PERCENT },
-	{ "**", TokenType::POWER },
-	{ "&", TokenType::AND },
-	{ "|", TokenType::OR },
-	{ "^", TokenType::XOR },
-	{ "<<", TokenType::LSHIFT },
-	{ ">>", TokenType::RSHIFT },
-	{ "~", TokenType::TILDE },
-	{ "!", TokenType::EXCL },
-	{ "!=", TokenType::EXCLEQ },
-	{ "<", TokenType::LESS },
-	{ ">", TokenType::GREATER },
-	{ "==", TokenType::EQEQ },
-	{ "<=", TokenType::LESSEQ },
-	{ ">=", TokenType::GREATEREQ },
-	{ "&&", TokenType::ANDAND },
-	{ "||", TokenType::OROR },
-	{ "(", TokenType::LPAR },
-	{ ")", TokenType::RPAR },
-	{ "{", TokenType::LBRACE },
-	{ "}", TokenType::RBRACE },
-	{ "[", TokenType::LBRACKET },
-	{ "]", TokenType::RBRACKET },
-	{ ",", TokenType::COMMA },
-	{ ".", TokenType::DOT },
-	{ "..", TokenType::RANGEDOT },
-	{ "...", TokenType::ETCETERA },
-	{ "?", TokenType::QUESTION },
-	{ ":", TokenType::COLON },
-	{ ";", TokenType::SEMICOLON },
-	{ "@", TokenType::AT }
-};
+// Perfect hash table of the key words, generated at compile time
+// The seed of FNV-1a is chosen so that no two key words fall into the same slot
+constexpr u32 KEY_WORDS_TABLE_SIZE = 512;
+
+constexpr u32 hashKeyWord(std::string_view s, u32 seed) {
+	u32 hash = 2166136261u ^ seed;
+	for (char c : s) {
+		hash ^= u8(c);
+		hash *= 16777619u;
+	}
 
-const std::string OP_CHARS = "=+-*/%&|^<>~!(){}[],.?:;@";
+	return hash % KEY_WORDS_TABLE_SIZE;
+}
 
+constexpr u32 findKeyWordsSeed() {
+	for (u32 seed = 0; ; seed++) {
+		bool isUsed[KEY_WORDS_TABLE_SIZE] = { };
+		bool hasCollision = false;
+		for (std::string_view keyWord : KEY_WORDS) {
+			u32 hash = hashKeyWord(keyWord, seed);
+			if (isUsed[hash]) {
+				hasCollision = true;
+				break;
+			}
 
-Lexer::Lexer(const std::string& text) 
-	: m_text(text) {
+			isUsed[hash] = true;
+		}
 
+		if (!hasCollision) {
+			return seed;
+		}
+	}
 }
 
-std::vector<Token> Lexer::tokenize() {
-	skipModuleQualities();
-	skipImports();
+constexpr u32 KEY_WORDS_SEED = findKeyWordsSeed();
 
-	while (m_pos < m_text.size()) {
-		nextToken();
+struct KeyWordsTable {
+	i8 indices[KEY_WORDS_TABLE_SIZE]; // index in KEY_WORDS or -1
+
+	constexpr KeyWordsTable() : indices() {
+		for (u32 i = 0; i < KEY_WORDS_TABLE_SIZE; i++) {
+			indices[i] = -1;
+		}
+
+		for (u32 i = 0; i < std::size(KEY_WORDS); i++) {
+			indices[hashKeyWord(KEY_WORDS[i], KEY_WORDS_SEED)] = i8(i);
+		}
 	}
+};
+
+constexpr KeyWordsTable KEY_WORDS_TABLE;
+
+// Character classes for the dispatch in Lexer::nextToken
+enum class CharClass : u8 {
+	OTHER = 0,
+	DIGIT,
+	LETTER, // including _
+	APOSTROPHE,
+	QUOTE,
+	HASH,
+	OPERATOR
+};
+
+struct CharClassTable {
+	CharClass classes[256];
+
+	constexpr CharClassTable() : classes() {
+		for (u32 c = '0'; c <= '9'; c++) classes[c] = CharClass::DIGIT;
+		for (u32 c = 'a'; c <= 'z'; c++) classes[c] = CharClass::LETTER;
+		for (u32 c = 'A'; c <= 'Z'; c++) classes[c] = CharClass::LETTER;
+		classes[u8('_')] = CharClass::LETTER;
+		classes[u8('\'')] = CharClass::APOSTROPHE;
+		classes[u8('"')] = CharClass::QUOTE;
+		classes[u8('#')] = CharClass::HASH;
+		for (char c : std::string_view("=+-*/%&|^<>~!(){}[],.?:;@")) {
+			classes[u8(c)] = CharClass::OPERATOR;
+		}
+	}
+};
+
+constexpr CharClassTable CHAR_CLASSES;
+
+constexpr CharClass getCharClass(char c) {
+	return CHAR_CLASSES.classes[u8(c)];
+}
+
+constexpr bool isIdentifierChar(char c) {
+	CharClass charClass = getCharClass(c);
+	return charClass == CharClass::LETTER || charClass == CharClass::DIGIT || c == '$';
+}
+
+
+Lexer::Lexer(std::string_view text) 
+	: m_text(text.data()), m_textSize(text.size()) {
 
-	return std::move(m_toks);
 }
 
-void Lexer::skipModuleQualities() {
+ModuleQualities Lexer::handleModuleQualities() {
+	m_areQualitiesHandled = true;
+
 	// read annotations
-	while (m_pos < m_text.size()) {
+	while (m_pos < m_textSize) {
 		skipWhitespaces(false);
-		if (m_pos < m_text.size() && m_text[m_pos] == '#') {
+		if (m_pos < m_textSize && m_text[m_pos] == '#') {
 			tokenizeComment();
 			continue;
 		}
 
-		if (m_pos >= m_text.size() - 3 || m_text[m_pos] != '@'
+		if (m_pos >= m_textSize - 3 || m_text[m_pos] != '@'
 			|| m_text[m_pos + 1] != 's' || m_text[m_pos + 2] != 'e' || m_text[m_pos + 3] != 't') break;
 
 		// skip @set
@@ -113,26 +144,108 @@ void Lexer::skipModuleQualities() {
 		next();
 
 		skipWhitespaces(true);
+		if (m_pos >= m_textSize || !(isalnum(m_text[m_pos]) || m_text[m_pos] == '_' || m_text[m_pos] == '&'))
+			ErrorManager::lexerError(
+				ErrorID::E1053_ANNOTATION_PARAMETER_UNSTATED,
+				m_line,
+				"the parameter of @set is unstated"
+			);
 
 		std::string parameter;
 		loadIdentifier(parameter);
 
 		skipWhitespaces(true);
+		if (m_pos >= m_textSize || !(isalnum(m_text[m_pos]) || m_text[m_pos] == '_' || m_text[m_pos] == '&'))
+			ErrorManager::lexerError(
+				ErrorID::E1054_ANNOTATION_VALUE_UNSTATED,
+				m_line,
+				"the value of @set is unstated"
+			);
 
 		m_buffer.clear();
 		loadIdentifier(m_buffer);
+
+		// parse the annotation
+		if (parameter == "visibility") {
+			if (m_buffer == "public") {
+				m_qualities.setVisibility(Visibility::PUBLIC);
+			} else if (m_buffer == "private") {
+				m_qualities.setVisibility(Visibility::PRIVATE);
+			} else if (m_buffer == "direct_import") {
+				m_qualities.setVisibility(Visibility::DIRECT_IMPORT);
+			} else {
+				ErrorManager::lexerError(
+					ErrorID::E1056_UNKNOWN_ANNOTATION_VALUE,
+					m_line,
+					"@set visibility " + m_buffer
+				);
+			}
+		} else if (parameter == "safety") {
+			if (m_buffer == "safe") {
+				m_qualities.setSafety(Safety::SAFE);
+			} else if (m_buffer == "unsafe") {
+				m_qualities.setSafety(Safety::UNSAFE);
+			} else if (m_buffer == "safe_only") {
+				m_qualities.setSafety(Safety::SAFE_ONLY);
+			} else {
+				ErrorManager::lexerError(
+					ErrorID::E1056_UNKNOWN_ANNOTATION_VALUE,
+					m_line,
+					"@set safety " + m_buffer
+				);
+			}
+		} else if (parameter == "mangling") {
+			if (m_buffer == "mangle") {
+				m_qualities.setMangling(true);
+			} else if (m_buffer == "nomangle") {
+				m_qualities.setMangling(false);
+			} else {
+				ErrorManager::lexerError(
+					ErrorID::E1056_UNKNOWN_ANNOTATION_VALUE,
+					m_line,
+					"@set mangling " + m_buffer
+				);
+			}
+		} else if (parameter == "default_imports") {
+			if (m_buffer == "true") {
+				m_qualities.setDefaultImports(true);
+			} else if (m_buffer == "false") {
+				m_qualities.setDefaultImports(false);
+			} else {
+				ErrorManager::lexerError(
+					ErrorID::E1056_UNKNOWN_ANNOTATION_VALUE,
+					m_line,
+					"@set default_imports " + m_buffer
+				);
+			}
+		} else {
+			ErrorManager::lexerError(
+				ErrorID::E1055_UNKNOWN_ANNOTATION_PARAMETER,
+				m_line,
+				"@set " + m_buffer
+			);
+		}
 	}
+
+	return m_qualities;
 }
 
-void Lexer::skipImports() {
-	while (m_pos < m_text.size()) {
+std::vector<std::string> Lexer::handleImports() {
+	if (!m_areQualitiesHandled) {
+		handleModuleQualities();
+	}
+
+	m_areImportsHandled = true;
+
+	ImportsHandler imports(m_qualities.isDefaultImports());
+	while (m_pos < m_textSize) {
 		skipWhitespaces(false);
-		if (m_pos < m_text.size() && m_text[m_pos] == '#') {
+		if (m_pos < m_textSize && m_text[m_pos] == '#') {
 			tokenizeComment();
 			continue;
 		}
 
-		if (m_pos < m_text.size() && m_text[m_pos] == 'i') {
+		if (m_pos < m_textSize && m_text[m_pos] == 'i') {
 			tokenizeWord();
 		} else {
 			break;
@@ -145,35 +258,62 @@ void Lexer::skipImports() {
 			m_buffer.clear();
 			skipWhitespaces(true);
 
-			while (m_pos < m_text.size() && m_text[m_pos] != ';') {
+			while (m_pos < m_textSize && m_text[m_pos] != ';') {
+				if (m_text[m_pos] == '\n' || m_text[m_pos] == '\r') {
+					ErrorManager::lexerError(
+						ErrorID::E1002_NO_ENDING_SEMICOLON,
+						m_line,
+						"import " + m_buffer
+					);
+				}
+
 				m_buffer += m_text[m_pos]; // read the module to import
 				next();
 			}
 
 			next(); // skip ;
 			skipWhitespaces(false);
+
+			m_importNames.push_back(m_buffer);
+			imports.addImport(m_buffer);
 		} else {
 			break;
 		}
 	}
+
+	return imports.getImportedFiles();
+}
+
+const std::vector<std::string>& Lexer::getImportNames() const {
+	return m_importNames;
+}
+
+std::vector<Token> Lexer::tokenize() {
+	if (!m_areImportsHandled) {
+		handleImports();
+	}
+
+	while (m_pos < m_textSize) {
+		nextToken();
+	}
+
+	++NumTokenizedModules;
+	NumTokens += m_toks.size();
+
+	return std::move(m_toks);
 }
 
 void Lexer::nextToken() {
-	if (isdigit(m_text[m_pos])) {
-		tokenizeNumber();
-	} else if (isalpha(m_text[m_pos]) || m_text[m_pos] == '_') {
-		tokenizeWord();
-	} else if (m_text[m_pos] == '\'') {
-		tokenizeCharacter();
-	} else if (m_text[m_pos] == '\"' ||
-		(m_pos < m_text.size() - 1 && m_text[m_pos] == 'f' && m_text[m_pos + 1] == '\"')) {
-		tokenizeText();
-	} else if (m_text[m_pos] == '#') {
-		tokenizeComment();
-	} else if (isOperator(m_text[m_pos])) {
-		tokenizeOperator();
-	} else {
+	switch (getCharClass(m_text[m_pos])) {
+		case CharClass::DIGIT: tokenizeNumber(); break;
+		case CharClass::LETTER: tokenizeWord(); break;
+		case CharClass::APOSTROPHE: tokenizeCharacter(); break;
+		case CharClass::QUOTE: tokenizeText(); break;
+		case CharClass::HASH: tokenizeComment(); break;
+		case CharClass::OPERATOR: tokenizeOperator(); break;
+	default:
 		next();
+		break;
 	}
 }
 
@@ -264,20 +404,12 @@ void Lexer::tokenizeNumber() {
 }
 
 void Lexer::tokenizeOperator() {
-	m_buffer.clear();
+	u32 length = 1;
+	TokenType type = matchOperator(length);
 
-	char c = m_text[m_pos];
-	while (c != '\0') {
-		m_buffer += c;
-		if (m_buffer.size() > 1) {
-			if (OPERATORS.find(m_buffer) == OPERATORS.end()) {
-				m_buffer.erase(m_buffer.size() - 1, 1);
-				m_toks.push_back(Token(OPERATORS[m_buffer], m_buffer, m_line));
-				return;
-			}
-		}
-
-		c = next();
+	m_toks.push_back(Token(type, std::string_view(m_text + m_pos, length), m_line));
+	while (length--) {
+		next();
 	}
 }
 
@@ -303,7 +435,7 @@ void Lexer::tokenizeText() {
 	}
 
 	while (true) {
-		if (m_pos >= m_text.size() - 1) {
+		if (m_pos >= m_textSize - 1) {
 			ErrorManager::lexerError(
 				ErrorID::E1112_NO_CLOSING_QUOTE, 
 				m_line, 
@@ -335,7 +467,7 @@ void Lexer::tokenizeText() {
 			m_toks.push_back(Token(TokenType::FORMAT_TEXT8, m_buffer, m_line));
 
 			// Note: Copied from tokenize() function
-			while (m_pos < m_text.size() - 1 && m_text[m_pos] != '}') {
+			while (m_pos < m_textSize - 1 && m_text[m_pos] != '}') {
 				nextToken();
 			}
 
@@ -384,10 +516,12 @@ void Lexer::tokenizeText() {
 
 	if (isFString) {
 		for (size_t pos : fStringParts) {
-			if (auto errCode = convertFunc(m_toks[pos].data)) {
+			std::string part = m_toks[pos].data();
+			if (auto errCode = convertFunc(part)) {
 				printStringTranslationError(errCode);
 			}
 
+			m_toks[pos].setData(part);
 			m_toks[pos].type = tok_type;
 		}
 
@@ -457,20 +591,19 @@ void Lexer::tokenizeCharacter() {
 }
 
 void Lexer::tokenizeWord() {
-	m_buffer.clear();
-	loadIdentifier(m_buffer);
+	std::string_view word = loadIdentifier();
 
-	int isKey = isKeyWord(m_buffer);
+	int isKey = isKeyWord(word);
 	if (isKey != -1) {
 		TokenType keyWord = TokenType(+TokenType::IMPORT + isKey);
 		if (keyWord == TokenType::ELIF) {
 			m_toks.push_back(Token(TokenType::ELSE, "else", m_line));
 			m_toks.push_back(Token(TokenType::IF, "if", m_line));
 		} else {
-			m_toks.push_back(Token(keyWord, m_buffer, m_line));
+			m_toks.push_back(Token(keyWord, word, m_line));
 		}
 	} else {
-		m_toks.push_back(Token(TokenType::WORD, m_buffer, m_line));
+		m_toks.push_back(Token(TokenType::WORD, word, m_line));
 	}
 }
 
@@ -483,16 +616,16 @@ void Lexer::tokenizeLine() {
 		c = next();
 	}
 
-	m_toks.back().data = m_buffer;
+	m_toks.back().setData(m_buffer);
 }
 
 void Lexer::tokenizeComment() {
-	if (m_pos < m_text.size() - 6 && m_text[m_pos + 1] == '#' && m_text[m_pos + 2] == '#') { // multiline comment
+	if (m_pos < m_textSize - 6 && m_text[m_pos + 1] == '#' && m_text[m_pos + 2] == '#') { // multiline comment
 		next();
 		next();
 		next();
 		while (true) {
-			if (m_pos == m_text.size()) {
+			if (m_pos == m_textSize) {
 				ErrorManager::lexerError(
 					ErrorID::E1003_MULTILINE_COMMENT_IS_NOT_CLOSED, 
 					m_line, 
@@ -504,7 +637,7 @@ void Lexer::tokenizeComment() {
 				skipString();
 			}
 			
-			if (m_pos < m_text.size() - 2) {
+			if (m_pos < m_textSize - 2) {
 				if (m_text[m_pos] == '#' && m_text[m_pos + 1] == '#' && m_text[m_pos + 2] == '#') {
 					next();
 					next();
@@ -525,11 +658,14 @@ void Lexer::tokenizeComment() {
 }
 
 void Lexer::loadIdentifier(std::string& to) {
-	char c = m_text[m_pos];
-	do {
-		to += c;
-		c = next();
-	} while (isalnum(c) || c == '_' || c == '$');
+	to += loadIdentifier();
+}
+
+std::string_view Lexer::loadIdentifier() {
+	u64 start = m_pos;
+	while (isIdentifierChar(next()));
+
+	return std::string_view(m_text + start, m_pos - start);
 }
 
 void Lexer::loadNumber(int base, bool allowFloating, bool allowDelimiter) {
@@ -626,6 +762,9 @@ void Lexer::loadNumber(int base, bool allowFloating, bool allowDelimiter) {
 
 u32 Lexer::getSingleChar() {
 	char c = next();
+	if (c == '\r' && m_text[m_pos + 1] == '\n') { // \r\n in a multiline string
+		c = next();
+	}
 
 	if (c == '\\') {
 		char b = next();
@@ -676,11 +815,11 @@ u32 Lexer::getSingleChar() {
 void Lexer::skipWhitespaces(bool spacesOnly) {
 	static std::string allSpaces = " \t\n\r\f\v";
 	if (spacesOnly) {
-		while (m_pos < m_text.size() && (m_text[m_pos] == ' ' || m_text[m_pos] == '\t')) {
+		while (m_pos < m_textSize && (m_text[m_pos] == ' ' || m_text[m_pos] == '\t')) {
 			next(); // skip whitespaces
 		}
 	} else {
-		while (m_pos < m_text.size() && allSpaces.find(m_text[m_pos]) != std::string::npos) {
+		while (m_pos < m_textSize && allSpaces.find(m_text[m_pos]) != std::string::npos) {
 			next(); // skip whitespaces
 		}
 	}
@@ -690,7 +829,7 @@ void Lexer::skipString() {
 	if (next() == '"') {
 		if (next() == '"') { // multiline string
 			while (true) {
-				if (m_pos >= m_text.size()) { // eof
+				if (m_pos >= m_textSize) { // eof
 					ErrorManager::lexerError(
 						ErrorID::E1112_NO_CLOSING_QUOTE,
 						m_line,
@@ -727,24 +866,111 @@ void Lexer::printStringTranslationError(u32 errCode) {
 	}
 }
 
-int Lexer::isKeyWord(std::string& s) {
-	for (int i = 0; i < KEY_WORDS.size(); i++) {
-		if (s == KEY_WORDS[i]) {
-			return i;
-		}
-	}
+TokenType Lexer::matchOperator(u32& length) const {
+	auto at = [this](u64 offset) -> char {
+		return m_pos + offset < m_textSize ? m_text[m_pos + offset] : '\0';
+	};
 
-	return -1;
+	// Maximal munch: every prefix of an operator is an operator as well
+	char c1 = at(1);
+	switch (m_text[m_pos]) {
+		case '=':
+			if (c1 == '=') { length = 2; return TokenType::EQEQ; }
+			return TokenType::EQ;
+		case '+':
+			if (c1 == '=') { length = 2; return TokenType::PLUS_EQ; }
+			if (c1 == '+') { length = 2; return TokenType::INCREMENT; }
+			return TokenType::PLUS;
+		case '-':
+			if (c1 == '=') { length = 2; return TokenType::MINUS_EQ; }
+			if (c1 == '-') { length = 2; return TokenType::DECREMENT; }
+			return TokenType::MINUS;
+		case '*':
+			if (c1 == '=') { length = 2; return TokenType::STAR_EQ; }
+			if (c1 == '*') {
+				if (at(2) == '=') { length = 3; return TokenType::POWER_EQ; }
+				length = 2;
+				return TokenType::POWER;
+			}
+
+			return TokenType::STAR;
+		case '/':
+			if (c1 == '=') { length = 2; return TokenType::SLASH_EQ; }
+			if (c1 == '/') {
+				if (at(2) == '=') { length = 3; return TokenType::DSLASH_EQ; }
+				length = 2;
+				return TokenType::DSLASH;
+			}
+
+			return TokenType::SLASH;
+		case '%':
+			if (c1 == '=') { length = 2; return TokenType::PERCENT_EQ; }
+			return TokenType::PERCENT;
+		case '&':
+			if (c1 == '=') { length = 2; return TokenType::AND_EQ; }
+			if (c1 == '&') { length = 2; return TokenType::ANDAND; }
+			return TokenType::AND;
+		case '|':
+			if (c1 == '=') { length = 2; return TokenType::OR_EQ; }
+			if (c1 == '|') { length = 2; return TokenType::OROR; }
+			return TokenType::OR;
+		case '^':
+			if (c1 == '=') { length = 2; return TokenType::XOR_EQ; }
+			return TokenType::XOR;
+		case '<':
+			if (c1 == '=') { length = 2; return TokenType::LESSEQ; }
+			if (c1 == '<') {
+				if (at(2) == '=') { length = 3; return TokenType::LSHIFT_EQ; }
+				length = 2;
+				return TokenType::LSHIFT;
+			}
+
+			return TokenType::LESS;
+		case '>':
+			if (c1 == '=') { length = 2; return TokenType::GREATEREQ; }
+			if (c1 == '>') {
+				if (at(2) == '=') { length = 3; return TokenType::RSHIFT_EQ; }
+				length = 2;
+				return TokenType::RSHIFT;
+			}
+
+			return TokenType::GREATER;
+		case '!':
+			if (c1 == '=') { length = 2; return TokenType::EXCLEQ; }
+			return TokenType::EXCL;
+		case '.':
+			if (c1 == '.') {
+				if (at(2) == '.') { length = 3; return TokenType::ETCETERA; }
+				length = 2;
+				return TokenType::RANGEDOT;
+			}
+
+			return TokenType::DOT;
+		case '~': return TokenType::TILDE;
+		case '(': return TokenType::LPAR;
+		case ')': return TokenType::RPAR;
+		case '{': return TokenType::LBRACE;
+		case '}': return TokenType::RBRACE;
+		case '[': return TokenType::LBRACKET;
+		case ']': return TokenType::RBRACKET;
+		case ',': return TokenType::COMMA;
+		case '?': return TokenType::QUESTION;
+		case ':': return TokenType::COLON;
+		case ';': return TokenType::SEMICOLON;
+		case '@': return TokenType::AT;
+	default:
+		ASSERT(false, "not an operator");
+		return TokenType::NO_TOKEN;
+	}
 }
 
-bool Lexer::isOperator(char ch) {
-	for (auto c : OP_CHARS) {
-		if (ch == c) {
-			return true;
-		}
+int Lexer::isKeyWord(std::string_view s) {
+	i8 index = KEY_WORDS_TABLE.indices[hashKeyWord(s, KEY_WORDS_SEED)];
+	if (index != -1 && KEY_WORDS[index] == s) {
+		return index;
 	}
 
-	return false;
+	return -1;
 }
 
 char Lexer::next() {
@@ -753,9 +979,10 @@ char Lexer::next() {
 		m_line = m_nextLine;
 	}
 
-	if (m_pos < m_text.size()) {
+	if (m_pos < m_textSize) {
+		// \r\n is a single line break
 		char r = m_text[m_pos];
-		if (r == '\n' || r == '\r') {
+		if (r == '\n' || (r == '\r' && m_text[m_pos + 1] != '\n')) {
 			m_nextLine++;
 		}
 
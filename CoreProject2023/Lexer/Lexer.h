@@ -11,26 +11,34 @@
 		2. Calling handleModuleQualities() to read module annotations.
 		3. Calling handleImports() to read the list of imports.
 		4. Calling tokenize() to get a vector of tokens.
+	Steps 2 and 3 can be omitted, then they are done by tokenize() and their results are discarded.
 */
 
 class Lexer {
 private:
 	std::vector<Token> m_toks;
-	const std::string& m_text;
+	const char* m_text; // null-terminated
+	u64 m_textSize;
 
 	std::string m_buffer;
 	u64 m_pos = 0;
 	u64 m_nextLine = 0;
 	u64 m_line = 0;
 
+	ModuleQualities m_qualities;
+	std::vector<std::string> m_importNames; // as written in the source, e.g. core.io.console
+	bool m_areQualitiesHandled = false;
+	bool m_areImportsHandled = false;
+
 public:
-	Lexer(const std::string& text);
+	// The text must be null-terminated (text.data()[text.size()] == '\0')
+	Lexer(std::string_view text);
 
-	std::vector<Token> tokenize();
+	ModuleQualities handleModuleQualities();
+	std::vector<std::string> handleImports();
+	const std::vector<std::string>& getImportNames() const;
 
-private:
-	void skipModuleQualities();
-	void skipImports();
+	std::vector<Token> tokenize();
 
 private:
 	void nextToken();
@@ -50,6 +58,9 @@ private:
 	// reads a word and stores it to to
 	void loadIdentifier(std::string &to);
 
+	// reads a word and returns the view of it in the text
+	std::string_view loadIdentifier();
+
 	// reads a number and stores it to m_buffer in decimal format
 	void loadNumber(int base, bool allowFloating, bool allowDelimiter);
 
@@ -60,8 +71,10 @@ private:
 	void skipString();
 	void printStringTranslationError(u32 errCode);
 
-	int isKeyWord(std::string& s);
-	bool isOperator(char ch);
+	// returns the longest operator at m_pos, its length is stored to length
+	TokenType matchOperator(u32& length) const;
+
+	int isKeyWord(std::string_view s);
 
 	char next();
 };
\ No newline at end of file
@@ -1,42 +1,17 @@
 #pragma once
 #include <vector>
-#include <fstream>
 #include <Utils/ErrorManager.h>
 #include <Module/Symbols/Annotations.h>
 #include <Module/Module.h>
 
-// Looks for module's qualities and imports
+// Reads and tokenizes the module (and recursively its imports) and adds it to the module list
+// The module's qualities and imports are read by the Lexer, the tokens are stored in the Module
+// so that the later stages (symbol preloading, loading, parsing) do not read the file again
 class ModulePeeker final {
-	ModuleQualities m_qualities;
-	std::vector<std::string> m_imports;
-
-	std::ifstream m_file;
 	std::string m_modulePath;
 
-	std::string m_buffer;
-	std::string m_text;
-	u64 m_pos = 0;
-	u64 m_line = 1;
-	u64 m_nextLine = 1;
-
 public:
 	ModulePeeker(std::string modulePath);
 
 	ModuleRef load();
-
-private:
-	void processModuleQualities();
-	void processImports();
-
-private:
-	void skipComment();
-	void skipString();
-
-	// reads a word and stores it to to
-	void loadIdentifier(std::string& to);
-
-private:
-	void skipWhitespaces(bool spacesOnly);
-
-	char next();
-};
\ No newline at end of file
+};
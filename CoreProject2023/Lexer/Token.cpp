@@ -1,4 +1,5 @@
 #include "Token.h"
+#include <Utils/StringInterner.h>
 
 static std::string TOKEN_NAMES[] = {
 	"NUMBERI8", "NUMBERU8", "NUMBERI16", "NUMBERU16", "NUMBERI32", "NUMBERU32", "NUMBERI64", "NUMBERU64", "NUMBERF32", "NUMBERF64",
@@ -72,22 +73,30 @@ bool isPossibleNumArgumentsOfOperator(TokenType op, u32 num) {
 }
 
 Token::Token()
-	: data(""), type(TokenType::NO_TOKEN), errLine(-1) {
+	: dataId(0), type(TokenType::NO_TOKEN), errLine(-1) {
 
 }
 
 Token::Token(TokenType type, int errLine) 
-	: data(""), type(type), errLine(errLine) {
+	: dataId(0), type(type), errLine(errLine) {
 
 }
 
-Token::Token(TokenType type, const std::string& data, int errLine) 
-	: data(data), type(type), errLine(errLine) {
+Token::Token(TokenType type, std::string_view data, int errLine) 
+	: dataId(g_stringInterner.intern(data)), type(type), errLine(errLine) {
 
 }
 
+const std::string& Token::data() const {
+	return g_stringInterner.get(dataId);
+}
+
+void Token::setData(std::string_view data) {
+	dataId = g_stringInterner.intern(data);
+}
+
 std::string Token::toString() const {
-	return TOKEN_NAMES[+type] + " \"" + data + "\" line " + std::to_string(errLine + 1);
+	return TOKEN_NAMES[+type] + " \"" + data() + "\" line " + std::to_string(errLine + 1);
 }
 
 std::string Token::toString(TokenType t) {
@@ -1,5 +1,6 @@
 #pragma once
 #include <string>
+#include <string_view>
 #include <Utils/Defs.h>
 
 enum class TokenType : u8 {
@@ -181,13 +182,16 @@ constexpr u8 operator+(TokenType t) {
 bool isPossibleNumArgumentsOfOperator(TokenType op, u32 num);
 
 struct Token {
-	std::string data;
+	u32 dataId; // id of the token's text in g_stringInterner
 	int errLine; // the line where the token is located in the text
 	TokenType type;
 
 	Token();
 	Token(TokenType type, int errLine);
-	Token(TokenType type, const std::string& data, int errLine);
+	Token(TokenType type, std::string_view data, int errLine);
+
+	const std::string& data() const;
+	void setData(std::string_view data);
 
 	std::string toString() const;
 	static std::string toString(TokenType t);
@@ -3,9 +3,8 @@
 llvm::LLVMContext g_context;
 std::unique_ptr<llvm::IRBuilder<>> g_builder = std::make_unique<llvm::IRBuilder<>>(g_context);
 
-// These two are initialized in Compiler::initAll()
+// Initialized in Compiler::initPasses() (setting "function-passes"), the module passes are run in Compiler::optimizeLLVMModule()
 std::unique_ptr<llvm::FunctionPassManager> g_functionPassManager;
-std::unique_ptr<llvm::ModulePassManager> g_modulePassManager;
 
 std::unique_ptr<llvm::ModuleAnalysisManager> g_moduleAnalysisManager = std::make_unique<llvm::ModuleAnalysisManager>();
 std::unique_ptr<llvm::FunctionAnalysisManager> g_functionAnalysisManager = std::make_unique<llvm::FunctionAnalysisManager>();
@@ -9,7 +9,6 @@ extern llvm::LLVMContext g_context;
 extern std::unique_ptr<llvm::IRBuilder<>> g_builder;
 
 extern std::unique_ptr<llvm::FunctionPassManager> g_functionPassManager;
-extern std::unique_ptr<llvm::ModulePassManager> g_modulePassManager;
 
 extern std::unique_ptr<llvm::ModuleAnalysisManager> g_moduleAnalysisManager;
 extern std::unique_ptr<llvm::FunctionAnalysisManager> g_functionAnalysisManager;
@@ -190,7 +190,7 @@ llvm::Value* llvm_utils::genFunctionArgumentValue(
 
 llvm::Value* llvm_utils::createLocalVariable(
 	llvm::Function* func, 
-	const std::shared_ptr<Type>& type, 
+	Type* type, 
 	const std::string& name
 ) {
 	llvm::IRBuilder<> tmpBuilder(&func->getEntryBlock(), func->getEntryBlock().begin());
@@ -214,7 +214,7 @@ llvm::Constant* llvm_utils::createGlobalValue(llvm::Type* type, llvm::Constant*
 	return globalValue;
 }
 
-llvm::Constant* llvm_utils::getDefaultValueOf(const std::shared_ptr<Type>& type) {
+llvm::Constant* llvm_utils::getDefaultValueOf(Type* type) {
 	llvm::Type* llvmType = type->to_llvm();
 	switch (type->basicType) {
 		case BasicType::NO_TYPE: return nullptr;
@@ -295,7 +295,7 @@ llvm::Constant* llvm_utils::getDefaultValueOf(const std::shared_ptr<Type>& type)
 	return nullptr;
 }
 
-llvm::Constant* llvm_utils::getZeroedValueOf(const std::shared_ptr<Type>& type) {
+llvm::Constant* llvm_utils::getZeroedValueOf(Type* type) {
 	llvm::Type* llvmType = type->to_llvm();
 	llvm::Constant* value = getConstantInt(
 		0, 
@@ -381,7 +381,7 @@ llvm::Constant* llvm_utils::getConstantString(
 	}
 }
 
-llvm::Value* llvm_utils::getStructValue(const std::vector<llvm::Value*> values, const std::shared_ptr<Type>& type) {
+llvm::Value* llvm_utils::getStructValue(const std::vector<llvm::Value*> values, Type* type) {
 	ASSERT(type->basicType == BasicType::STRUCT || type->basicType == BasicType::DYN_ARRAY
 		|| isString(type->basicType) || type->basicType == BasicType::TUPLE, "");
 
@@ -398,8 +398,8 @@ llvm::Value* llvm_utils::getStructValue(const std::vector<llvm::Value*> values,
 }
 
 llvm::Value* llvm_utils::tryImplicitlyConvertTo(
-	const std::shared_ptr<Type>& to, 
-	const std::shared_ptr<Type>& from,
+	Type* to, 
+	Type* from,
 	llvm::Value* value, 
 	u64 errLine, 
 	bool isFromCompileTime
@@ -414,8 +414,8 @@ llvm::Value* llvm_utils::tryImplicitlyConvertTo(
 }
 
 llvm::Value* llvm_utils::convertValueTo(
-	const std::shared_ptr<Type>& to, 
-	const std::shared_ptr<Type>& from, 
+	Type* to, 
+	Type* from, 
 	llvm::Value* value
 ) {
 	if (to->equalsOrLessConstantThan(from) >= -4096) { // equals not considering constantness
@@ -533,14 +533,14 @@ llvm::Value* llvm_utils::convertValueTo(
 	return nullptr;
 }
 
-llvm::Value* llvm_utils::convertToString(const std::shared_ptr<Type>& from, llvm::Value* value, BasicType stringType) {
+llvm::Value* llvm_utils::convertToString(Type* from, llvm::Value* value, BasicType stringType) {
 	TypeNode& stringNode = getBasicTypeNode(stringType);
 	// TODO: implement
 
 	return nullptr;
 }
 
-llvm::Value* llvm_utils::convertToBool(const std::shared_ptr<Type>& from, llvm::Value* value) {
+llvm::Value* llvm_utils::convertToBool(Type* from, llvm::Value* value) {
 	if (from->basicType == BasicType::BOOL) {
 		return value;
 	}
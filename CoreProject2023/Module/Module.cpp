@@ -1,11 +1,18 @@
 #include "Module.h"
 #include <ranges>
+#include <llvm/ADT/Hashing.h>
 #include <Utils/ErrorManager.h>
 #include <Utils/AggregatorIterator.h>
+#include <Utils/Statistics.h>
 #include <Project/Project.h>
 #include <Parser/AST/INode.h>
 #include "LLVMUtils.h"
 #include "LLVMGlobals.h"
+#include "ModuleInterface.h"
+
+STATISTIC(NumSymbolTypeLookups, "symbols", "symbol type lookups (getSymbolType)");
+STATISTIC(NumFunctionChoices, "symbols", "overload resolutions (chooseFunction, chooseConstructor, chooseOperator)");
+STATISTIC(NumOverloadCacheHits, "symbols", "overload resolutions found in the cache");
 
 ModuleList g_moduleList;
 ModuleRef g_module;
@@ -31,6 +38,18 @@ auto makeAggregatorIteratorForAlias(
 	return result;
 }
 
+size_t OverloadKeyHash::operator()(const OverloadKey& key) const {
+	return llvm::hash_combine(
+		u8(key.symType),
+		key.flag,
+		key.compileTimeMask,
+		key.type,
+		key.moduleAlias,
+		key.name,
+		llvm::hash_combine_range(key.argTypes.begin(), key.argTypes.end())
+	);
+}
+
 
 std::shared_ptr<llvm::Module> LLVMModuleManager::getLLVMModule(const std::string& name) {
 	static std::shared_ptr<llvm::Module> s_llvmModule;
@@ -50,12 +69,14 @@ Module::Module(
 	const std::string& name, 
 	const std::string& path, 
 	ModuleQualities qualities, 
-	std::vector<std::string> imports
+	std::vector<std::string> imports,
+	std::vector<Token> tokens
 ) : 
 	m_name(name),
 	m_path(path), 
 	m_qualities(qualities), 
 	m_importedModules(std::move(imports)),
+	m_tokens(std::move(tokens)),
 	m_llvmModule(LLVMModuleManager::getLLVMModule(name)),
 	m_ownSymbols(std::make_unique<ModuleSymbols>())
 {
@@ -72,25 +93,19 @@ Module::Module(Module& other)
 }
 
 void Module::loadImportsList() {
-	if (m_allTheImportedModules.size()) {
+	if (m_allTheImportedModules.any()) {
 		return;
 	}
 
-	m_allTheImportedModules.insert(m_path);
+	m_allTheImportedModules.resize(g_moduleList.getModules().size());
+	m_allTheImportedModules.set(m_id);
 	for (auto& importedModulePath : m_importedModules) {
 		ModuleRef module = g_moduleList.getModule(importedModulePath);
-		m_allTheImportedModules.insert(module->getPath());
 		m_symbols[module->getName()] = { };
 
 		// Loading indirectly imported module's symbols
 		module->loadImportsList();
-		const auto& subimportedModules = module->getAllTheImportedModules();
-
-		for (auto& subimportedModule : subimportedModules) {
-			if (!m_allTheImportedModules.contains(subimportedModule)) {
-				m_allTheImportedModules.insert(subimportedModule);
-			}
-		}
+		m_allTheImportedModules |= module->getAllTheImportedModules();
 	}
 }
 
@@ -102,7 +117,8 @@ void Module::loadSymbols() {
 		m_allTheImportedModules.clear();
 	}
 
-	m_allTheImportedModules.insert(m_path);
+	m_allTheImportedModules.resize(g_moduleList.getModules().size());
+	m_allTheImportedModules.set(m_id);
 	for (auto& importedModulePath : m_importedModules) {
 		ModuleRef module = g_moduleList.getModule(importedModulePath);
 		module->loadSymbols();
@@ -111,24 +127,29 @@ void Module::loadSymbols() {
 		auto& moduleSymbols = module->getOwnSymbols();
 		addModuleSymbolsUnit(module->getName(), &moduleSymbols.publicOnceSymbols);
 		addModuleSymbolsUnit(module->getName(), &moduleSymbols.publicSymbols);
-		m_allTheImportedModules.insert(module->getPath());
+		m_allTheImportedModules.set(module->getId());
 
 		// Loading indirectly imported module's symbols
-		const auto& subimportedModules = module->getAllTheImportedModules();
-
-		for (auto& subimportedModule : subimportedModules) {
-			if (!m_allTheImportedModules.contains(subimportedModule)) {
-				m_allTheImportedModules.insert(subimportedModule);
-				addModuleSymbolsUnit(
-					g_moduleList.getModule(subimportedModule)->getName(),
-					&g_moduleList.getModule(subimportedModule)->getOwnSymbols().publicSymbols
-				);
+		for (u32 subimportedModuleId : module->getAllTheImportedModules().set_bits()) {
+			if (!m_allTheImportedModules.test(subimportedModuleId)) {
+				m_allTheImportedModules.set(subimportedModuleId);
+
+				ModuleRef subimportedModule = g_moduleList.getModule(subimportedModuleId);
+				addModuleSymbolsUnit(subimportedModule->getName(), &subimportedModule->getOwnSymbols().publicSymbols);
 			}
 		}
 	}
 }
 
 void Module::loadAsLLVM() {
+	// The prototypes are complete only once the symbols are loaded
+	invalidateOverloadCache();
+
+	if (m_interface) {
+		m_interface->declareSymbols(*this);
+		return;
+	}
+
 	loadThisModuleUnit(&m_ownSymbols->privateSymbols);
 	loadThisModuleUnit(&m_ownSymbols->publicOnceSymbols);
 	loadThisModuleUnit(&m_ownSymbols->publicSymbols);
@@ -141,6 +162,7 @@ void Module::addAlias(
 	std::string alias
 ) {
 	if (symType == SymbolType::MODULE) {
+		invalidateOverloadCache();
 		if (m_moduleAliases.contains(alias)) {
 			m_moduleAliases[alias].push_back(name);
 		} else {
@@ -166,36 +188,45 @@ void Module::addAlias(
 }
 
 void Module::addBlock() {
-	m_localVariables.push_back(Variable{ "", nullptr, VariableQualities(), nullptr });
+	m_blocks.push_back(u32(m_localVariables.size()));
 }
 
 void Module::addLocalVariable(
 	const std::string& name, 
-	std::shared_ptr<Type> type, 
+	Type* type, 
 	VariableQualities qualities, 
 	llvm::Value* value
 ) {
-	std::shared_ptr<LLVMVariableManager> variableManager = std::make_shared<LLVMVariableManager>();
-	variableManager->setInitialValue(value);
-	m_localVariables.push_back(Variable{ name, std::move(type), qualities, std::move(variableManager) });
+	u32 index = u32(m_localVariables.size());
+	m_localVariables.push_back(Variable::createLocal(name, type, qualities, value));
+
+	auto [it, isNew] = m_localVariableIndices.try_emplace(name, index);
+	m_shadowedLocalVariables.push_back(isNew ? NO_LOCAL_VARIABLE : it->second);
+	it->second = index;
 }
 
 void Module::deleteBlock() {
-	while (true) {
-		if (m_localVariables.back().name == "") {
-			m_localVariables.pop_back();
-			break;
+	u32 blockBeginning = m_blocks.back();
+	m_blocks.pop_back();
+
+	// The variables of the block are removed in reverse, so each name gets back the variable it shadowed
+	while (m_localVariables.size() > blockBeginning) {
+		u32 shadowed = m_shadowedLocalVariables.back();
+		if (shadowed == NO_LOCAL_VARIABLE) {
+			m_localVariableIndices.erase(m_localVariables.back().name);
+		} else {
+			m_localVariableIndices[m_localVariables.back().name] = shadowed;
 		}
 
 		m_localVariables.pop_back();
+		m_shadowedLocalVariables.pop_back();
 	}
 }
 
 SymbolType Module::getSymbolType(const std::string& name) {
-	for (auto it = m_localVariables.rbegin(); it != m_localVariables.rend(); it++) {
-		if (it->name == name) {
-			return SymbolType::VARIABLE;
-		}
+	++NumSymbolTypeLookups;
+	if (findLocalVariable(name)) {
+		return SymbolType::VARIABLE;
 	}
 
 	if (m_symbols.contains(name) || m_moduleAliases.contains(name)) {
@@ -213,6 +244,7 @@ SymbolType Module::getSymbolType(const std::string& name) {
 }
 
 SymbolType Module::getSymbolType(const std::string& moduleAlias, const std::string& name) {
+	++NumSymbolTypeLookups;
 	if (!m_symbols.contains(moduleAlias) && !m_moduleAliases.contains(moduleAlias)) {
 		ErrorManager::internalError(ErrorID::E4052_NO_MODULE_FOUND_BY_ALIAS, -1,
 			"alias is: " + moduleAlias + ", symbol: " + name);
@@ -221,10 +253,8 @@ SymbolType Module::getSymbolType(const std::string& moduleAlias, const std::stri
 	}
 
 	if (moduleAlias == "") {
-		for (auto it = m_localVariables.rbegin(); it != m_localVariables.rend(); it++) {
-			if (it->name == name) {
-				return SymbolType::VARIABLE;
-			}
+		if (findLocalVariable(name)) {
+			return SymbolType::VARIABLE;
 		}
 	}
 
@@ -261,7 +291,7 @@ Function* Module::getFunction(const std::string& moduleAlias, const std::string&
 Function* Module::getFunction(
 	const std::string& moduleAlias,
 	const std::string& name,
-	const std::vector<std::shared_ptr<Type>>& argTypes,
+	const std::vector<Type*>& argTypes,
 	const std::vector<bool>& isCompileTime
 ) {
 	auto&& iter = makeAggregatorIteratorForAlias(m_symbols, m_moduleAliases, moduleAlias);
@@ -277,84 +307,93 @@ Function* Module::getFunction(
 Function* Module::chooseFunction(
 	const std::string& moduleAlias,
 	const std::string& name,
-	const std::vector<std::shared_ptr<Type>>& argTypes,
+	const std::vector<Type*>& argTypes,
 	const std::vector<bool>& isCompileTime
 ) {
-	Function* result = nullptr;
-	i32 bestScore = -1;
+	++NumFunctionChoices;
+	return resolveOverload(SymbolType::FUNCTION, false, nullptr, moduleAlias, name, argTypes, isCompileTime, [&]() -> Function* {
+		Function* result = nullptr;
+		i32 bestScore = -1;
+
+		auto&& iter = makeAggregatorIteratorForAlias(m_symbols, m_moduleAliases, moduleAlias);
+		for (ModuleSymbolsUnit* unit = iter.begin(); !iter.is_end(); unit = iter.next()) {
+			if (auto fun = unit->chooseFunction(name, argTypes, isCompileTime); fun != nullptr) {
+				i32 score = fun->prototype.getSuitableness(argTypes, isCompileTime);
+				if (result == nullptr || score < bestScore) {
+					bestScore = score;
+					result = fun;
 
-	auto&& iter = makeAggregatorIteratorForAlias(m_symbols, m_moduleAliases, moduleAlias);
-	for (ModuleSymbolsUnit* unit = iter.begin(); !iter.is_end(); unit = iter.next()) {
-		if (auto fun = unit->chooseFunction(name, argTypes, isCompileTime); fun != nullptr) {
-			i32 score = fun->prototype.getSuitableness(argTypes, isCompileTime);
-			if (result == nullptr || score < bestScore) {
-				bestScore = score;
-				result = fun;
-
-				if (score == 0) {
-					return fun;
+					if (score == 0) {
+						return fun;
+					}
 				}
 			}
 		}
-	}
 
-	return result;
+		return result;
+	});
 }
 
 Function* Module::chooseConstructor(
-	const std::shared_ptr<Type>& type,
-	const std::vector<std::shared_ptr<Type>>& argTypes,
+	Type* type,
+	const std::vector<Type*>& argTypes,
 	const std::vector<bool>& isCompileTime,
 	bool isImplicit
 ) {
-	Function* result = nullptr;
-	i32 bestScore = -1;
-
-	for (auto& symbols : m_symbols) {
-		for (ModuleSymbolsUnit* unit : symbols.second) {
-			if (auto fun = unit->chooseConstructor(type, argTypes, isCompileTime, isImplicit); fun != nullptr) {
-				i32 score = fun->prototype.getSuitableness(argTypes, isCompileTime);
-				if (result == nullptr || score < bestScore) {
-					bestScore = score;
-					result = fun;
-
-					if (score == 0) {
-						return fun;
+	++NumFunctionChoices;
+	return resolveOverload(SymbolType::CONSTRUCTOR, isImplicit, type, "", "", argTypes, isCompileTime, [&]() -> Function* {
+		Function* result = nullptr;
+		i32 bestScore = -1;
+
+		for (auto& symbols : m_symbols) {
+			for (ModuleSymbolsUnit* unit : symbols.second) {
+				if (auto fun = unit->chooseConstructor(type, argTypes, isCompileTime, isImplicit); fun != nullptr) {
+					i32 score = fun->prototype.getSuitableness(argTypes, isCompileTime);
+					if (result == nullptr || score < bestScore) {
+						bestScore = score;
+						result = fun;
+
+						if (score == 0) {
+							return fun;
+						}
 					}
 				}
 			}
 		}
-	}
 
-	return result;
+		return result;
+	});
 }
 
 Function* Module::chooseOperator(
 	const std::string& name,
-	const std::vector<std::shared_ptr<Type>>& argTypes,
+	const std::vector<Type*>& argTypes,
 	const std::vector<bool>& isCompileTime,
 	bool mustReturnReference
 ) {
-	Function* result = nullptr;
-	i32 bestScore = -1;
-
-	for (auto& symbols : m_symbols) {
-		for (ModuleSymbolsUnit* unit : symbols.second) {
-			if (auto fun = unit->chooseOperator(name, argTypes, isCompileTime, mustReturnReference); fun != nullptr) {
-				i32 score = fun->prototype.getSuitableness(argTypes, isCompileTime);
-				if (result == nullptr || score < bestScore) {
-					bestScore = score;
-					result = fun;
-
-					if (score == 0) {
-						return fun;
+	++NumFunctionChoices;
+	return resolveOverload(SymbolType::OPERATOR, mustReturnReference, nullptr, "", name, argTypes, isCompileTime, [&]() -> Function* {
+		Function* result = nullptr;
+		i32 bestScore = -1;
+
+		for (auto& symbols : m_symbols) {
+			for (ModuleSymbolsUnit* unit : symbols.second) {
+				if (auto fun = unit->chooseOperator(name, argTypes, isCompileTime, mustReturnReference); fun != nullptr) {
+					i32 score = fun->prototype.getSuitableness(argTypes, isCompileTime);
+					if (result == nullptr || score < bestScore) {
+						bestScore = score;
+						result = fun;
+
+						if (score == 0) {
+							return fun;
+						}
 					}
 				}
 			}
 		}
-	}
 
-	return result;
+		return result;
+	});
 }
 
 Variable* Module::getVariable(u64 tokenPos) {
@@ -367,10 +406,8 @@ Variable* Module::getVariable(const std::string& name) {
 
 Variable* Module::getVariable(const std::string& moduleAlias, const std::string& name) {
 	if (moduleAlias == "") {
-		for (auto it = m_localVariables.rbegin(); it != m_localVariables.rend(); it++) {
-			if (it->name == name) {
-				return &*it;
-			}
+		if (Variable* local = findLocalVariable(name)) {
+			return local;
 		}
 	}
 
@@ -411,6 +448,10 @@ const std::string& Module::getPath() const noexcept {
 	return m_path;
 }
 
+u32 Module::getId() const noexcept {
+	return m_id;
+}
+
 ModuleQualities Module::getQualities() const noexcept {
 	return m_qualities;
 }
@@ -419,7 +460,24 @@ const std::vector<std::string>& Module::getImports() const noexcept {
 	return m_importedModules;
 }
 
-const std::set < std::string>& Module::getAllTheImportedModules() const {
+ModuleInterface* Module::getInterface() const noexcept {
+	return m_interface.get();
+}
+
+void Module::setInterface(std::shared_ptr<ModuleInterface> moduleInterface) {
+	m_interface = std::move(moduleInterface);
+}
+
+std::vector<Token>& Module::getTokens() {
+	return m_tokens;
+}
+
+void Module::clearTokens() {
+	m_tokens.clear();
+	m_tokens.shrink_to_fit();
+}
+
+const llvm::BitVector& Module::getAllTheImportedModules() const {
 	return m_allTheImportedModules;
 }
 
@@ -431,6 +489,54 @@ llvm::Module& Module::getLLVMModule() {
 	return *m_llvmModule;
 }
 
+Variable* Module::findLocalVariable(const std::string& name) {
+	auto it = m_localVariableIndices.find(name);
+	return it == m_localVariableIndices.end() ? nullptr : &m_localVariables[it->second];
+}
+
+Function* Module::resolveOverload(
+	SymbolType symType,
+	bool flag,
+	Type* type,
+	const std::string& moduleAlias,
+	const std::string& name,
+	const std::vector<Type*>& argTypes,
+	const std::vector<bool>& isCompileTime,
+	llvm::function_ref<Function*()> resolve
+) {
+	// The compile-time flags are kept as a mask, resolutions with more arguments are not memoized
+	u64 compileTimeMask = 0;
+	for (size_t i = 0; i < isCompileTime.size(); i++) {
+		if (isCompileTime[i]) {
+			if (i >= 64) {
+				return resolve();
+			}
+
+			compileTimeMask |= u64(1) << i;
+		}
+	}
+
+	if (m_overloadCacheGeneration != ModuleSymbolsUnit::getGeneration()) {
+		invalidateOverloadCache();
+	}
+
+	OverloadKey key{ symType, flag, compileTimeMask, type, moduleAlias, name, { argTypes.begin(), argTypes.end() } };
+	if (auto it = m_overloadCache.find(key); it != m_overloadCache.end()) {
+		++NumOverloadCacheHits;
+		return it->second;
+	}
+
+	// The resolution can resolve other overloads (implicit conversions by constructors), so the key is inserted afterwards
+	Function* result = resolve();
+	m_overloadCache.try_emplace(std::move(key), result);
+	return result;
+}
+
+void Module::invalidateOverloadCache() {
+	m_overloadCache.clear();
+	m_overloadCacheGeneration = ModuleSymbolsUnit::getGeneration();
+}
+
 void Module::loadThisModuleUnit(ModuleSymbolsUnit* unit) {
 	// Addind to module's LLVM IR
 	for (Function& func : unit->getFunctions()) {
@@ -459,6 +565,7 @@ void Module::addModuleSymbolsUnit(const std::string& alias, ModuleSymbolsUnit* u
 
 	// Adding to the module's symbols
 	m_symbols[alias].push_back(unit);
+	invalidateOverloadCache();
 }
 
 std::string Module::getModuleNameFromPath(const std::string& path) {
@@ -476,20 +583,25 @@ std::string Module::getModulePathWithoutName(const std::string& path) {
 
 
 ModuleRef ModuleList::addModule(Module module) {
+	u32 id = u32(m_modules.size());
+	module.m_id = id;
+	m_moduleIds[module.getPath()] = id;
 	m_modules.emplace_back(module);
-	return ModuleRef(m_modules.size() - 1);
+	return ModuleRef(id);
 }
 
 ModuleRef ModuleList::getModule(const std::string& path) {
-	for (size_t i = 0; i < m_modules.size(); i++) {
-		if (m_modules[i].getPath() == path) {
-			return ModuleRef(i);
-		}
+	if (auto it = m_moduleIds.find(path); it != m_moduleIds.end()) {
+		return ModuleRef(it->second);
 	}
 
 	return ModuleRef();
 }
 
+ModuleRef ModuleList::getModule(u32 id) {
+	return ModuleRef(id);
+}
+
 void ModuleList::setCurrentModule(const std::string& path) {
 	if (auto mod = getModule(path); mod) {
 		g_module = mod;
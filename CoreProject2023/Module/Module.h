@@ -1,29 +1,71 @@
 #pragma once
 #include <llvm/IR/Module.h>
+#include <llvm/ADT/BitVector.h>
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/ADT/STLFunctionalExtras.h>
+#include <Lexer/Token.h>
 #include "ModuleSymbols.h"
 
+class ModuleInterface;
+
 namespace LLVMModuleManager {
 	std::shared_ptr<llvm::Module> getLLVMModule(const std::string& name);
 };
 
+// The arguments of an overload resolution (chooseFunction, chooseConstructor, chooseOperator)
+struct OverloadKey {
+	SymbolType symType;
+	bool flag; // isImplicit for constructors, mustReturnReference for operators
+	u64 compileTimeMask;
+	Type* type; // the constructed type
+	std::string moduleAlias;
+	std::string name;
+	llvm::SmallVector<Type*, 4> argTypes; // the types are interned, so the pointers identify them
+
+	bool operator==(const OverloadKey& other) const = default;
+};
+
+struct OverloadKeyHash {
+	size_t operator()(const OverloadKey& key) const;
+};
+
 class Module final {
+	friend class ModuleList;
+
 private:
 	std::string m_name;
 	std::string m_path;
+	u32 m_id = u32(-1); // index in g_moduleList, assigned once the module is added there
 	ModuleQualities m_qualities;
 	std::shared_ptr<llvm::Module> m_llvmModule;
 	std::vector<std::string> m_importedModules;
 
+	// the module is tokenized once by ModulePeeker, the tokens are used by all the later stages
+	std::vector<Token> m_tokens;
+
 	// key "" means accessible without stating any module/namespace
 	std::map<std::string, std::vector<ModuleSymbolsUnit*>> m_symbols;
 	std::unique_ptr<ModuleSymbols> m_ownSymbols;
 
 	std::map<std::string, std::vector<std::string>> m_moduleAliases;
 
-	// needed to get symbols from imports in imported modules
-	std::set<std::string> m_allTheImportedModules; 
+	// needed to get symbols from imports in imported modules, indexed by module id
+	llvm::BitVector m_allTheImportedModules;
 
+	// The local variables of the blocks being parsed/generated, in the order of declaration
 	std::vector<Variable> m_localVariables;
+	std::vector<u32> m_shadowedLocalVariables; // for each local, the index of the local with the same name it shadows
+	std::unordered_map<std::string, u32> m_localVariableIndices; // name -> index of the innermost local
+	std::vector<u32> m_blocks; // the number of locals at the beginning of each block
+
+	static constexpr u32 NO_LOCAL_VARIABLE = u32(-1);
+
+	// The memoized overload resolutions, valid while no symbols are added (ModuleSymbolsUnit::getGeneration())
+	std::unordered_map<OverloadKey, Function*, OverloadKeyHash> m_overloadCache;
+	u64 m_overloadCacheGeneration = 0;
+
+	// Set if the module is loaded from its interface instead of the source
+	std::shared_ptr<ModuleInterface> m_interface;
 
 	bool m_areSymbolsLoaded = false;
 
@@ -32,7 +74,8 @@ public:
 		const std::string& name,
 		const std::string& path, 
 		ModuleQualities qualities, 
-		std::vector<std::string> imports
+		std::vector<std::string> imports,
+		std::vector<Token> tokens
 	);
 
 	Module(Module& other);
@@ -53,7 +96,7 @@ public:
 	void addBlock();
 	void addLocalVariable(
 		const std::string& name, 
-		std::shared_ptr<Type> type, 
+		Type* type, 
 		VariableQualities qualities, 
 		llvm::Value* value
 	);
@@ -73,7 +116,7 @@ public:
 	Function* getFunction(
 		const std::string& moduleAlias,
 		const std::string& name,
-		const std::vector<std::shared_ptr<Type>>& argTypes,
+		const std::vector<Type*>& argTypes,
 		const std::vector<bool>& isCompileTime
 	);
 
@@ -81,20 +124,20 @@ public:
 	Function* chooseFunction(
 		const std::string& moduleAlias,
 		const std::string& name,
-		const std::vector<std::shared_ptr<Type>>& argTypes,
+		const std::vector<Type*>& argTypes,
 		const std::vector<bool>& isCompileTime
 	);
 
 	Function* chooseConstructor(
-		const std::shared_ptr<Type>& type,
-		const std::vector<std::shared_ptr<Type>>& argTypes,
+		Type* type,
+		const std::vector<Type*>& argTypes,
 		const std::vector<bool>& isCompileTime,
 		bool isImplicit
 	);
 
 	Function* chooseOperator(
 		const std::string& name,
-		const std::vector<std::shared_ptr<Type>>& argTypes,
+		const std::vector<Type*>& argTypes,
 		const std::vector<bool>& isCompileTime,
 		bool mustReturnReference = false
 	);
@@ -109,15 +152,37 @@ public:
 
 	const std::string& getName() const noexcept;
 	const std::string& getPath() const noexcept;
+	u32 getId() const noexcept;
 	ModuleQualities getQualities() const noexcept;
 
 	const std::vector<std::string>& getImports() const noexcept;
-	const std::set<std::string>& getAllTheImportedModules() const;
+
+	ModuleInterface* getInterface() const noexcept;
+	void setInterface(std::shared_ptr<ModuleInterface> moduleInterface);
+
+	std::vector<Token>& getTokens();
+	void clearTokens(); // to be called once the module is generated
+	const llvm::BitVector& getAllTheImportedModules() const;
 
 	ModuleSymbols& getOwnSymbols();
 	llvm::Module& getLLVMModule();
 
 private:
+	Function* resolveOverload(
+		SymbolType symType,
+		bool flag,
+		Type* type,
+		const std::string& moduleAlias,
+		const std::string& name,
+		const std::vector<Type*>& argTypes,
+		const std::vector<bool>& isCompileTime,
+		llvm::function_ref<Function*()> resolve
+	);
+
+	void invalidateOverloadCache();
+
+	Variable* findLocalVariable(const std::string& name);
+
 	void loadThisModuleUnit(ModuleSymbolsUnit* unit);
 	void addModuleSymbolsUnit(const std::string& alias, ModuleSymbolsUnit* unit);
 
@@ -145,10 +210,12 @@ public:
 class ModuleList final {
 private:
 	std::vector<Module> m_modules;
+	std::unordered_map<std::string, u32> m_moduleIds; // path -> module id
 
 public:
 	ModuleRef addModule(Module module);
 	ModuleRef getModule(const std::string& path);
+	ModuleRef getModule(u32 id);
 	void setCurrentModule(const std::string& path);
 
 	std::vector<Module>& getModules();
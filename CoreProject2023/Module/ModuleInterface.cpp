@@ -0,0 +1,713 @@
+#include "ModuleInterface.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <llvm/IR/GlobalVariable.h>
+#include <llvm/Support/xxhash.h>
+#include <Utils/ErrorManager.h>
+#include <Utils/SourceBuffer.h>
+#include <Lexer/Lexer.h>
+#include <Lexer/ImportsHandler.h>
+#include <Project/Project.h>
+#include "Module.h"
+#include "LLVMUtils.h"
+
+// Must be changed along with any change of the format or of BasicType
+constexpr char INTERFACE_MAGIC[8] = { 'C', 'O', 'R', 'E', 'I', 'F', '\0', 1 };
+
+// The units in the order they are stored, only the types are stored for the private one
+// (they can be a part of the types of public symbols)
+constexpr u32 INTERFACE_UNITS_COUNT = 3;
+
+ModuleSymbolsUnit& getInterfaceUnit(ModuleSymbols& symbols, u32 index) {
+	switch (index) {
+		case 0: return symbols.publicSymbols;
+		case 1: return symbols.publicOnceSymbols;
+	default: return symbols.privateSymbols;
+	}
+}
+
+u64 getSourceTextHash(SourceBuffer* source) {
+	std::string_view text = source->getText();
+	return llvm::xxHash64(llvm::StringRef(text.data(), text.size()));
+}
+
+
+// Serializes the symbols into the interface's binary format (little-endian numbers, strings with u32 sizes)
+class InterfaceWriter final {
+private:
+	std::string m_data;
+	std::map<const TypeNode*, u32> m_typeModules; // the id of the module the type is declared in
+	u32 m_moduleId;
+	std::map<u32, u32> m_dependencyIndices; // module id -> index in the table of dependencies
+
+public:
+	static constexpr u32 THIS_MODULE = u32(-1);
+	static constexpr u32 UNKNOWN_MODULE = u32(-2);
+
+	InterfaceWriter(Module& writtenModule, const std::vector<u32>& dependencies)
+		: m_moduleId(writtenModule.getId()) {
+		for (auto& module : g_moduleList.getModules()) {
+			for (u32 i = 0; i < INTERFACE_UNITS_COUNT; i++) {
+				for (auto& type : getInterfaceUnit(module.getOwnSymbols(), i).getTypes()) {
+					m_typeModules[type.get()] = module.getId();
+				}
+			}
+		}
+
+		for (u32 i = 0; i < u32(dependencies.size()); i++) {
+			m_dependencyIndices[dependencies[i]] = i;
+		}
+	}
+
+	void writeU8(u8 value) {
+		m_data += char(value);
+	}
+
+	void writeU32(u32 value) {
+		for (u32 i = 0; i < 4; i++) {
+			m_data += char((value >> (i * 8)) & 0xff);
+		}
+	}
+
+	void writeU64(u64 value) {
+		for (u32 i = 0; i < 8; i++) {
+			m_data += char((value >> (i * 8)) & 0xff);
+		}
+	}
+
+	void writeString(std::string_view value) {
+		writeU32(u32(value.size()));
+		m_data.append(value);
+	}
+
+	void writeType(Type* type) {
+		writeU8(u8(type->basicType));
+		writeU8(type->isConst);
+
+		switch (type->basicType) {
+			case BasicType::ARRAY:
+				writeType(type->asArrayType()->elementType);
+				writeU64(type->asArrayType()->size);
+				break;
+			case BasicType::DYN_ARRAY:
+			case BasicType::POINTER:
+			case BasicType::XVAL_REFERENCE:
+			case BasicType::LVAL_REFERENCE:
+			case BasicType::RVAL_REFERENCE:
+			case BasicType::OPTIONAL:
+				writeType(type->asPointerType()->elementType);
+				break;
+			case BasicType::TUPLE:
+				writeTypes(type->asTupleType()->subTypes);
+				break;
+			case BasicType::FUNCTION:
+				writeType(type->asFunctionType()->returnType);
+				writeTypes(type->asFunctionType()->argTypes);
+				writeU8(type->asFunctionType()->isVaArgs);
+				break;
+			case BasicType::STRUCT:
+				writeTypes(type->asStructType()->fieldTypes);
+				break;
+			case BasicType::TYPE_NODE: {
+				// Types are referred to by their module's index in the table of dependencies and by their name,
+				// so that the interface would not depend on the order of the imports and on the paths
+				TypeNode* node = type->asTypeNodeType()->node.get();
+				auto moduleIt = m_typeModules.find(node);
+				if (moduleIt == m_typeModules.end()) {
+					writeU32(UNKNOWN_MODULE);
+				} else if (moduleIt->second == m_moduleId) {
+					writeU32(THIS_MODULE);
+				} else {
+					auto indexIt = m_dependencyIndices.find(moduleIt->second);
+					writeU32(indexIt == m_dependencyIndices.end() ? UNKNOWN_MODULE : indexIt->second);
+				}
+
+				writeString(node->name);
+			} break;
+		default: break;
+		}
+	}
+
+	void writeTypes(const std::vector<Type*>& types) {
+		writeU32(u32(types.size()));
+		for (auto& type : types) {
+			writeType(type);
+		}
+	}
+
+	void writeFunctionName(const FunctionPrototype& prototype) {
+		writeString(prototype.getName());
+		writeU64(prototype.getQualities().getData());
+		writeU8(prototype.isVaArgs());
+	}
+
+	void writeFunctionTypes(Function& function) {
+		writeType(function.prototype.getReturnType());
+		writeU32(u32(function.prototype.args().size()));
+		for (auto& arg : function.prototype.args()) {
+			writeString(arg.name);
+			writeType(arg.type);
+		}
+
+		// The name of the definition, so that the functions imported through use would refer to the original
+		llvm::Function* value = function.functionManager->getOriginalValue();
+		if (value && !value->isDeclaration()) {
+			writeString(value->getName().str());
+		} else {
+			writeString(function.prototype.getLLVMName());
+		}
+	}
+
+	std::string& getData() {
+		return m_data;
+	}
+};
+
+
+// Reads the interface's binary format, any read outside the file is an error
+class InterfaceReader final {
+private:
+	const std::string& m_path;
+	const char* m_begin;
+	const char* m_pos;
+	const char* m_end;
+	const std::vector<ModuleRef>* m_dependencies; // the modules the types are declared in, by their indices
+
+public:
+	InterfaceReader(const std::string& path, const llvm::MemoryBuffer& buffer, u64 offset, const std::vector<ModuleRef>* dependencies = nullptr)
+		: m_path(path), m_begin(buffer.getBufferStart()), m_pos(buffer.getBufferStart() + offset), m_end(buffer.getBufferEnd()),
+		m_dependencies(dependencies) {
+
+	}
+
+	u8 readU8() {
+		require(1);
+		return u8(*m_pos++);
+	}
+
+	u32 readU32() {
+		require(4);
+		u32 result = 0;
+		for (u32 i = 0; i < 4; i++) {
+			result |= u32(u8(*m_pos++)) << (i * 8);
+		}
+
+		return result;
+	}
+
+	u64 readU64() {
+		require(8);
+		u64 result = 0;
+		for (u32 i = 0; i < 8; i++) {
+			result |= u64(u8(*m_pos++)) << (i * 8);
+		}
+
+		return result;
+	}
+
+	std::string_view readString() {
+		u32 size = readU32();
+		require(size);
+
+		std::string_view result(m_pos, size);
+		m_pos += size;
+		return result;
+	}
+
+	Type* readType(Module& module) {
+		BasicType basicType = BasicType(readU8());
+		bool isConst = readU8();
+
+		switch (basicType) {
+			case BasicType::ARRAY: {
+				Type* elementType = readType(module);
+				return ArrayType::createType(elementType, readU64(), isConst);
+			}
+			case BasicType::DYN_ARRAY:
+			case BasicType::POINTER:
+			case BasicType::XVAL_REFERENCE:
+			case BasicType::LVAL_REFERENCE:
+			case BasicType::RVAL_REFERENCE:
+			case BasicType::OPTIONAL:
+				return PointerType::createType(basicType, readType(module), isConst);
+			case BasicType::TUPLE:
+				return TupleType::createType(readTypes(module), isConst);
+			case BasicType::FUNCTION: {
+				Type* returnType = readType(module);
+				std::vector<Type*> argTypes = readTypes(module);
+				return FunctionType::createType(returnType, std::move(argTypes), readU8(), isConst);
+			}
+			case BasicType::STRUCT:
+				return StructType::createType(readTypes(module), isConst);
+			case BasicType::TYPE_NODE: {
+				ModuleRef typeModule = readTypeModule(module);
+				std::string_view name = readString();
+				return TypeNodeType::createType(findTypeNode(*typeModule, name), isConst);
+			}
+		default:
+			if (basicType > BasicType::UNKNOWN) {
+				error("unknown type");
+			}
+
+			return Type::createType(basicType, isConst);
+		}
+	}
+
+	std::vector<Type*> readTypes(Module& module) {
+		std::vector<Type*> result(readU32());
+		for (auto& type : result) {
+			type = readType(module);
+		}
+
+		return result;
+	}
+
+	// Reads the prototype's return type and arguments, returns the LLVM name of the function
+	std::string readFunctionTypes(Module& module, FunctionPrototype& prototype) {
+		prototype.setReturnType(readType(module));
+
+		std::vector<Argument> args;
+		u32 argsCount = readU32();
+		for (u32 i = 0; i < argsCount; i++) {
+			std::string name = std::string(readString());
+			args.push_back(Argument{ std::move(name), readType(module) });
+		}
+
+		prototype.setArgs(std::move(args));
+		return std::string(readString());
+	}
+
+	FunctionPrototype readFunctionName() {
+		std::string name = std::string(readString());
+		FunctionQualities qualities;
+		qualities.setData(readU64());
+		bool isVaArgs = readU8();
+
+		return FunctionPrototype(name, nullptr, { }, qualities, isVaArgs);
+	}
+
+	u64 getOffset() const {
+		return u64(m_pos - m_begin);
+	}
+
+	[[noreturn]] void error(const std::string& message) {
+		ErrorManager::internalError(ErrorID::E4054_BROKEN_MODULE_INTERFACE, -1, m_path + ": " + message);
+		quick_exit(0);
+	}
+
+private:
+	void require(u64 size) {
+		if (u64(m_end - m_pos) < size) {
+			error("unexpected end of file");
+		}
+	}
+
+	ModuleRef readTypeModule(Module& module) {
+		u32 index = readU32();
+		if (index == InterfaceWriter::THIS_MODULE) {
+			return g_moduleList.getModule(module.getId());
+		} else if (index == InterfaceWriter::UNKNOWN_MODULE) {
+			error("the module of a type is unknown");
+		} else if (!m_dependencies || index >= m_dependencies->size()) {
+			error("wrong module of a type");
+		} else if (!(*m_dependencies)[index]) {
+			error("the module of a type is not imported");
+		}
+
+		return (*m_dependencies)[index];
+	}
+
+	std::shared_ptr<TypeNode> findTypeNode(Module& module, std::string_view name) {
+		std::string typeName(name);
+		for (u32 i = 0; i < INTERFACE_UNITS_COUNT; i++) {
+			if (auto result = getInterfaceUnit(module.getOwnSymbols(), i).getType(typeName)) {
+				return result;
+			}
+		}
+
+		error("type " + module.getName() + "." + typeName + " not found");
+	}
+};
+
+
+ModuleInterface::ModuleInterface(std::string path, std::unique_ptr<llvm::MemoryBuffer> buffer)
+	: m_path(std::move(path)), m_buffer(std::move(buffer)) {
+
+}
+
+std::shared_ptr<ModuleInterface> ModuleInterface::find(const std::string& modulePath) {
+	if (!g_settings->useInterfaces) {
+		return nullptr;
+	}
+
+	// The modules being compiled are always loaded from the sources
+	auto& compiledModules = g_settings->compiledCoreModules;
+	if (std::find(compiledModules.begin(), compiledModules.end(), modulePath) != compiledModules.end()) {
+		return nullptr;
+	}
+
+	// The buffer is not cached in SourceBuffer, so that an outdated interface would not stay mapped when it is rewritten
+	std::string path = getInterfacePath(modulePath);
+	llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> buffer = llvm::MemoryBuffer::getFile(path, false, false);
+	if (!buffer) {
+		return nullptr;
+	}
+
+	std::shared_ptr<ModuleInterface> result = std::make_shared<ModuleInterface>(path, std::move(*buffer));
+	if (!result->readHeader()) {
+		return nullptr;
+	}
+
+	// If the source is present, the interface is used only if it was built from the same source
+	if (SourceBuffer* source = SourceBuffer::get(modulePath)) {
+		if (getSourceTextHash(source) != result->m_sourceHash || !std::filesystem::exists(result->m_objectFile)) {
+			return nullptr;
+		}
+	}
+
+	// The types and the functions of the imported modules are a part of the module's code
+	// A module that is not found is reported once the imports are handled
+	for (auto& [name, hash] : result->m_dependencies) {
+		std::string path = ImportsHandler::findImportPath(modulePath, name);
+		if (path != "" && getModuleSourceHash(path) != hash) {
+			return nullptr;
+		}
+	}
+
+	return result;
+}
+
+bool ModuleInterface::exists(const std::string& modulePath) {
+	return std::filesystem::exists(modulePath)
+		|| (g_settings->useInterfaces && std::filesystem::exists(getInterfacePath(modulePath)));
+}
+
+void ModuleInterface::write(Module& module, const std::string& objectFile) {
+	SourceBuffer* source = SourceBuffer::get(module.getPath());
+	if (!source) {
+		return;
+	}
+
+	// All the imported modules, ordered by their import names so that the interface would not depend on the order of the imports
+	std::vector<std::pair<std::string, u32>> dependencies;
+	for (u32 id : module.getAllTheImportedModules().set_bits()) {
+		if (id != module.getId()) {
+			dependencies.emplace_back(ImportsHandler::getImportName(module.getPath(), g_moduleList.getModule(id)->getPath()), id);
+		}
+	}
+
+	std::sort(dependencies.begin(), dependencies.end());
+
+	std::vector<u32> dependencyIds;
+	for (auto& [name, id] : dependencies) {
+		dependencyIds.push_back(id);
+	}
+
+	InterfaceWriter writer(module, dependencyIds);
+
+	// Header
+	writer.getData().append(INTERFACE_MAGIC, sizeof(INTERFACE_MAGIC));
+	writer.writeU64(getSourceTextHash(source));
+	writer.writeU64(module.getQualities().getData());
+
+	// The imports are stored as they are written in the source, so that they would be searched for as for the source
+	{
+		std::string prevFilePath = std::move(g_currFilePath);
+		g_currFilePath = module.getPath();
+
+		Lexer lexer(source->getText());
+		lexer.handleImports();
+
+		writer.writeU32(u32(lexer.getImportNames().size()));
+		for (auto& name : lexer.getImportNames()) {
+			writer.writeString(name);
+		}
+
+		g_currFilePath = std::move(prevFilePath);
+	}
+
+	// The object file is stored relatively to the interface, so that they could be moved together
+	std::filesystem::path interfaceDir = std::filesystem::absolute(getInterfacePath(module.getPath())).parent_path();
+	std::filesystem::path objectPath = std::filesystem::absolute(objectFile).lexically_normal();
+	std::filesystem::path relativeObjectPath = objectPath.lexically_relative(interfaceDir);
+	writer.writeString(relativeObjectPath.empty() ? objectPath.generic_string() : relativeObjectPath.generic_string());
+
+	writer.writeU32(u32(dependencies.size()));
+	for (auto& [name, id] : dependencies) {
+		writer.writeString(name);
+		writer.writeU64(getModuleSourceHash(g_moduleList.getModule(id)->getPath()));
+	}
+
+	// Names
+	ModuleSymbols& symbols = module.getOwnSymbols();
+	for (u32 i = 0; i < INTERFACE_UNITS_COUNT; i++) {
+		ModuleSymbolsUnit& unit = getInterfaceUnit(symbols, i);
+		bool isPrivate = i == INTERFACE_UNITS_COUNT - 1;
+
+		writer.writeU32(u32(unit.getTypes().size()));
+		for (auto& type : unit.getTypes()) {
+			writer.writeString(type->name);
+			writer.writeU64(type->qualities.getData());
+		}
+
+		writer.writeU32(isPrivate ? 0 : u32(unit.getVariables().size()));
+		for (auto& var : unit.getVariables()) {
+			if (isPrivate) break;
+
+			writer.writeString(var.name);
+			writer.writeU64(var.qualities.getData());
+		}
+
+		for (auto* functions : { &unit.getFunctions(), &unit.getConstructors(), &unit.getOperators() }) {
+			writer.writeU32(isPrivate ? 0 : u32(functions->size()));
+			for (auto& function : *functions) {
+				if (isPrivate) break;
+
+				writer.writeFunctionName(function.prototype);
+			}
+		}
+	}
+
+	// Types
+	for (u32 i = 0; i < INTERFACE_UNITS_COUNT; i++) {
+		ModuleSymbolsUnit& unit = getInterfaceUnit(symbols, i);
+		bool isPrivate = i == INTERFACE_UNITS_COUNT - 1;
+
+		for (auto& type : unit.getTypes()) {
+			writer.writeU8(type->type != nullptr);
+			if (type->type) {
+				writer.writeType(type->type);
+			}
+
+			writer.writeU32(u32(type->fields.size()));
+			for (auto& field : type->fields) {
+				writer.writeString(field.name);
+				writer.writeU64(field.qualities.getData());
+				writer.writeType(field.type);
+			}
+
+			writer.writeU32(u32(type->methods.size()));
+			for (auto& method : type->methods) {
+				writer.writeFunctionName(method.prototype);
+				writer.writeFunctionTypes(method);
+			}
+		}
+
+		if (isPrivate) {
+			continue;
+		}
+
+		for (auto& var : unit.getVariables()) {
+			writer.writeType(var.type);
+
+			llvm::Value* value = var.valueManager->getOriginalValue();
+			writer.writeString(value && llvm::isa<llvm::GlobalValue>(value) ? value->getName().str() : var.name);
+		}
+
+		for (auto* functions : { &unit.getFunctions(), &unit.getConstructors(), &unit.getOperators() }) {
+			for (auto& function : *functions) {
+				writer.writeFunctionTypes(function);
+			}
+		}
+	}
+
+	std::ofstream file(getInterfacePath(module.getPath()), std::ios::binary);
+	file.write(writer.getData().data(), writer.getData().size());
+}
+
+std::string ModuleInterface::getInterfacePath(const std::string& modulePath) {
+	return modulePath + "if"; // -module-.core -> -module-.coreif
+}
+
+void ModuleInterface::preloadSymbols(Module& module) {
+	InterfaceReader reader(m_path, *m_buffer, m_symbolsOffset);
+	ModuleSymbols& symbols = module.getOwnSymbols();
+
+	for (u32 i = 0; i < INTERFACE_UNITS_COUNT; i++) {
+		ModuleSymbolsUnit& unit = getInterfaceUnit(symbols, i);
+
+		u32 typesCount = reader.readU32();
+		for (u32 j = 0; j < typesCount; j++) {
+			std::string name = std::string(reader.readString());
+			TypeQualities qualities;
+			qualities.setData(reader.readU64());
+
+			unit.addType(std::make_shared<TypeNode>(std::move(name), qualities, nullptr, nullptr));
+		}
+
+		u32 variablesCount = reader.readU32();
+		for (u32 j = 0; j < variablesCount; j++) {
+			std::string name = std::string(reader.readString());
+			VariableQualities qualities;
+			qualities.setData(reader.readU64());
+
+			unit.addVariable(name, nullptr, qualities, nullptr);
+		}
+
+		u32 functionsCount = reader.readU32();
+		for (u32 j = 0; j < functionsCount; j++) {
+			unit.addFunction(reader.readFunctionName());
+		}
+
+		u32 constructorsCount = reader.readU32();
+		for (u32 j = 0; j < constructorsCount; j++) {
+			unit.addConstructor(reader.readFunctionName());
+		}
+
+		u32 operatorsCount = reader.readU32();
+		for (u32 j = 0; j < operatorsCount; j++) {
+			unit.addOperator(reader.readFunctionName());
+		}
+	}
+
+	m_typesOffset = reader.getOffset();
+}
+
+void ModuleInterface::loadSymbols(Module& module) {
+	// The modules are found by their import names in the same way as the imports
+	std::vector<ModuleRef> dependencies;
+	for (auto& [name, hash] : m_dependencies) {
+		std::string path = ImportsHandler::findImportPath(module.getPath(), name);
+		ModuleRef dependency = g_moduleList.getModule(path);
+		if (!dependency && path != "") {
+			// The path may be written differently from the one the module was imported by
+			std::filesystem::path normalPath = std::filesystem::absolute(path).lexically_normal();
+			for (auto& other : g_moduleList.getModules()) {
+				if (std::filesystem::absolute(other.getPath()).lexically_normal() == normalPath) {
+					dependency = g_moduleList.getModule(other.getId());
+					break;
+				}
+			}
+		}
+
+		dependencies.push_back(dependency);
+	}
+
+	InterfaceReader reader(m_path, *m_buffer, m_typesOffset, &dependencies);
+	ModuleSymbols& symbols = module.getOwnSymbols();
+
+	for (u32 i = 0; i < INTERFACE_UNITS_COUNT; i++) {
+		ModuleSymbolsUnit& unit = getInterfaceUnit(symbols, i);
+
+		// The same as in SymbolLoader
+		for (auto& type : unit.getTypes()) {
+			if (reader.readU8()) {
+				type->type = reader.readType(module);
+				type->llvmType = type->type->to_llvm();
+			}
+
+			u32 fieldsCount = reader.readU32();
+			for (u32 j = 0; j < fieldsCount; j++) {
+				std::string name = std::string(reader.readString());
+				VariableQualities qualities;
+				qualities.setData(reader.readU64());
+
+				type->fields.push_back(Variable(std::move(name), reader.readType(module), qualities, nullptr));
+			}
+
+			u32 methodsCount = reader.readU32();
+			type->methods.reserve(methodsCount);
+			for (u32 j = 0; j < methodsCount; j++) {
+				Function& method = type->methods.emplace_back(reader.readFunctionName(), nullptr);
+				std::string llvmName = reader.readFunctionTypes(module, method.prototype);
+				m_functionNames.emplace_back(&method, std::move(llvmName));
+			}
+		}
+
+		for (auto& var : unit.getVariables()) {
+			var.type = reader.readType(module);
+			m_variableNames.emplace_back(&var, std::string(reader.readString()));
+		}
+
+		for (auto* functions : { &unit.getFunctions(), &unit.getConstructors(), &unit.getOperators() }) {
+			for (auto& function : *functions) {
+				std::string llvmName = reader.readFunctionTypes(module, function.prototype);
+				m_functionNames.emplace_back(&function, std::move(llvmName));
+			}
+		}
+	}
+}
+
+void ModuleInterface::declareSymbols(Module& module) {
+	// The code is in the object file, so all the symbols are external
+	for (auto& [function, llvmName] : m_functionNames) {
+		llvm::Function* value = function->prototype.generate();
+		value->setLinkage(llvm::Function::ExternalLinkage);
+		if (value->getName() != llvmName) {
+			value->setName(llvmName);
+		}
+
+		function->functionManager->setInitialValue(value);
+	}
+
+	for (auto& [var, llvmName] : m_variableNames) {
+		llvm::Value* value = llvm_utils::addGlobalVariableFromOtherModule(*var, module.getLLVMModule());
+		if (value->getName() != llvmName) {
+			value->setName(llvmName);
+		}
+
+		var->valueManager->setInitialValue(value);
+	}
+}
+
+ModuleQualities ModuleInterface::getQualities() const {
+	return m_qualities;
+}
+
+const std::vector<std::string>& ModuleInterface::getImportNames() const {
+	return m_importNames;
+}
+
+const std::string& ModuleInterface::getObjectFile() const {
+	return m_objectFile;
+}
+
+bool ModuleInterface::readHeader() {
+	if (m_buffer->getBufferSize() < sizeof(INTERFACE_MAGIC)
+		|| memcmp(m_buffer->getBufferStart(), INTERFACE_MAGIC, sizeof(INTERFACE_MAGIC)) != 0) {
+		return false;
+	}
+
+	InterfaceReader reader(m_path, *m_buffer, sizeof(INTERFACE_MAGIC));
+	m_sourceHash = reader.readU64();
+	m_qualities.setData(reader.readU64());
+
+	u32 importsCount = reader.readU32();
+	for (u32 i = 0; i < importsCount; i++) {
+		m_importNames.push_back(std::string(reader.readString()));
+	}
+
+	std::filesystem::path objectFile = std::string(reader.readString());
+	if (objectFile.is_relative()) {
+		objectFile = std::filesystem::path(m_path).parent_path() / objectFile;
+	}
+
+	m_objectFile = objectFile.lexically_normal().generic_string();
+
+	u32 dependenciesCount = reader.readU32();
+	for (u32 i = 0; i < dependenciesCount; i++) {
+		std::string name = std::string(reader.readString());
+		m_dependencies.emplace_back(std::move(name), reader.readU64());
+	}
+
+	m_symbolsOffset = reader.getOffset();
+	return true;
+}
+
+u64 ModuleInterface::getModuleSourceHash(const std::string& modulePath) {
+	if (SourceBuffer* source = SourceBuffer::get(modulePath)) {
+		return getSourceTextHash(source);
+	}
+
+	// A module shipped without the source
+	std::string path = getInterfacePath(modulePath);
+	llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> buffer = llvm::MemoryBuffer::getFile(path, false, false);
+	if (!buffer) {
+		return 0;
+	}
+
+	ModuleInterface moduleInterface(path, std::move(*buffer));
+	return moduleInterface.readHeader() ? moduleInterface.m_sourceHash : 0;
+}
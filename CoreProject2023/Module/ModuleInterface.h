@@ -0,0 +1,73 @@
+#pragma once
+#include <memory>
+#include <string>
+#include <vector>
+#include <llvm/Support/MemoryBuffer.h>
+#include "Symbols/Annotations.h"
+
+class Module;
+struct Function;
+struct Variable;
+
+/*
+	The binary interface of a compiled module (-module-.coreif, next to -module-.core).
+	Contains the symbols other modules can use (types, variables, functions, constructors, operators) with their types
+	and LLVM names, and the path to the object file with their code.
+	The modules it depends on (all the imported ones, directly and indirectly) are stored by their import names
+	(the paths relative to the directories they are imported from) along with the hashes of their sources.
+	An imported module is loaded from its interface instead of the source if the setting "use-interfaces" is on,
+	the module is not one of the compiled modules, either the source is not found or it did not change,
+	and the sources of the modules it depends on did not change either.
+
+	The file is memory-mapped and read in the same stages as a source module:
+		1. preloadSymbols() adds the symbols with their names and qualities (instead of SymbolPreloader).
+		2. loadSymbols() reads the types of the symbols (instead of SymbolLoader).
+		3. declareSymbols() adds the symbols to the llvm::Module as external ones (instead of Module::loadAsLLVM).
+*/
+
+class ModuleInterface final {
+private:
+	std::string m_path;
+	std::unique_ptr<llvm::MemoryBuffer> m_buffer;
+
+	u64 m_sourceHash = 0;
+	ModuleQualities m_qualities;
+	std::vector<std::string> m_importNames;
+	std::string m_objectFile;
+	std::vector<std::pair<std::string, u64>> m_dependencies; // import name -> hash of the source
+
+	u64 m_symbolsOffset = 0; // where the symbols' names start
+	u64 m_typesOffset = 0; // where the symbols' types start, set by preloadSymbols
+
+	// LLVM names read by loadSymbols, the symbols are declared under these names
+	std::vector<std::pair<Function*, std::string>> m_functionNames;
+	std::vector<std::pair<Variable*, std::string>> m_variableNames;
+
+public:
+	ModuleInterface(std::string path, std::unique_ptr<llvm::MemoryBuffer> buffer);
+
+	// Returns the interface to be loaded instead of the module's source, nullptr if there is no suitable one
+	static std::shared_ptr<ModuleInterface> find(const std::string& modulePath);
+
+	// Whether the module can be imported (its source or its interface exists)
+	static bool exists(const std::string& modulePath);
+
+	// Writes the interface of a module which is already compiled to the object file
+	static void write(Module& module, const std::string& objectFile);
+
+	static std::string getInterfacePath(const std::string& modulePath);
+
+	void preloadSymbols(Module& module);
+	void loadSymbols(Module& module);
+	void declareSymbols(Module& module);
+
+	ModuleQualities getQualities() const;
+	const std::vector<std::string>& getImportNames() const;
+	const std::string& getObjectFile() const;
+
+private:
+	bool readHeader();
+
+	// The hash of the module's source, or the one stored in its interface if there is no source (0 if there is neither)
+	static u64 getModuleSourceHash(const std::string& modulePath);
+};
@@ -1,104 +1,95 @@
 #include "ModuleSymbols.h"
 #include <Module/LLVMGlobals.h>
 
+u64 ModuleSymbolsUnit::s_generation = 0;
+
 void ModuleSymbolsUnit::addType(std::shared_ptr<TypeNode> type) {
+	s_generation++;
+	m_nameIndex[type->name].types.push_back(u32(m_types.size()));
 	m_types.push_back(std::move(type));
 }
 
 void ModuleSymbolsUnit::addFunction(FunctionPrototype prototype) {
+	s_generation++;
+	m_nameIndex[prototype.getName()].functions.push_back(u32(m_functions.size()));
 	m_functions.push_back(Function{ std::move(prototype), nullptr });
 }
 
 void ModuleSymbolsUnit::addConstructor(FunctionPrototype prototype) {
+	s_generation++;
+	m_nameIndex[prototype.getName()].constructors.push_back(u32(m_constructors.size()));
 	m_constructors.push_back(Function{ std::move(prototype), nullptr });
 }
 
 void ModuleSymbolsUnit::addOperator(FunctionPrototype prototype) {
+	s_generation++;
+	m_nameIndex[prototype.getName()].operators.push_back(u32(m_operators.size()));
 	m_operators.push_back(Function{ std::move(prototype), nullptr });
 }
 
 void ModuleSymbolsUnit::addFunction(FunctionPrototype proto, std::shared_ptr<LLVMFunctionManager> manager) {
+	s_generation++;
+	m_nameIndex[proto.getName()].functions.push_back(u32(m_functions.size()));
 	m_functions.push_back(Function{ std::move(proto), std::move(manager) });
 }
 
 void ModuleSymbolsUnit::addVariable(
 	const std::string& name,
-	std::shared_ptr<Type> type,
+	Type* type,
 	VariableQualities qualities,
 	std::shared_ptr<LLVMVariableManager> value
 ) {
-	m_variables.push_back(Variable{ name, std::move(type), qualities, std::move(value) });
+	s_generation++;
+	m_nameIndex[name].variables.push_back(u32(m_variables.size()));
+	m_variables.push_back(Variable{ name, type, qualities, std::move(value) });
 }
 
 SymbolType ModuleSymbolsUnit::getSymbolType(const std::string& name) const {
-	static std::set<std::string> OPERATOR_STRINGS = { 
-		"in", "is", "=", "+=", "-=", "*=", "/=", "//=", "%=", "**=", "&=", "|=",
-		"^=", ">>=", "<<=", "++", "--", "+", "-", "*", "/", "//", "**",
-		"&", "|", "^", ">>", "<<", "~", "!", "!=", "<", ">", "==", "<=", ">=",
-		"(", "[", ".."
-	};
-
-	if (OPERATOR_STRINGS.contains(name)) {
-		for (auto& fun : m_operators) {
-			if (fun.prototype.getName() == name) {
-				return SymbolType::OPERATOR;
-			}
-		}
-	} else {
-		for (auto& var : m_variables) {
-			if (var.name == name) {
-				return SymbolType::VARIABLE;
-			}
-		}
-
-		for (auto& fun : m_functions) {
-			if (fun.prototype.getName() == name) {
-				return SymbolType::FUNCTION;
-			}
-		}
-
-		for (auto& fun : m_constructors) {
-			if (fun.prototype.getName() == name) {
-				return SymbolType::CONSTRUCTOR;
-			}
-		}
+	const SymbolNameEntry* entry = findName(name);
+	if (entry == nullptr) {
+		return SymbolType::NO_SYMBOL;
+	}
 
-		for (auto& type : m_types) {
-			if (type->name == name) {
-				return SymbolType::TYPE;
-			}
-		}
+	// Operator names cannot be used as identifiers, so there is no ambiguity
+	if (entry->operators.size()) {
+		return SymbolType::OPERATOR;
+	} else if (entry->variables.size()) {
+		return SymbolType::VARIABLE;
+	} else if (entry->functions.size()) {
+		return SymbolType::FUNCTION;
+	} else if (entry->constructors.size()) {
+		return SymbolType::CONSTRUCTOR;
+	} else if (entry->types.size()) {
+		return SymbolType::TYPE;
 	}
 
 	return SymbolType::NO_SYMBOL;
 }
 
 Function* ModuleSymbolsUnit::getFunction(const std::string& name) {
-	Function* result = nullptr;
-	for (auto& fun : m_functions) {
-		if (fun.prototype.getName() == name) {
-			if (result != nullptr) {
-				return nullptr;
-			}
-
-			result = &fun;
-		}
+	const SymbolNameEntry* entry = findName(name);
+	if (entry == nullptr || entry->functions.size() != 1) {
+		return nullptr;
 	}
 
-	return result;
+	return &m_functions[entry->functions[0]];
 }
 
 Function* ModuleSymbolsUnit::getFunction(
 	const std::string& name,
-	const std::vector<std::shared_ptr<Type>>& argTypes,
+	const std::vector<Type*>& argTypes,
 	const std::vector<bool>& isCompileTime
 ) {
-	for (auto& fun : m_functions) {
-		if (fun.prototype.getName() == name) {
-			i32 score = fun.prototype.getSuitableness(argTypes, isCompileTime);
-			if (score == 0) {
-				return &fun;
-			}
+	const SymbolNameEntry* entry = findName(name);
+	if (entry == nullptr) {
+		return nullptr;
+	}
+
+	for (u32 index : entry->functions) {
+		Function& fun = m_functions[index];
+		i32 score = fun.prototype.getSuitableness(argTypes, isCompileTime);
+		if (score == 0) {
+			return &fun;
 		}
 	}
 
@@ -107,25 +98,29 @@ Function* ModuleSymbolsUnit::getFunction(
 
 Function* ModuleSymbolsUnit::chooseFunction(
 	const std::string& name,
-	const std::vector<std::shared_ptr<Type>>& argTypes,
+	const std::vector<Type*>& argTypes,
 	const std::vector<bool>& isCompileTime
 ) {
+	const SymbolNameEntry* entry = findName(name);
+	if (entry == nullptr) {
+		return nullptr;
+	}
+
 	Function* result = nullptr;
 	i32 bestScore = -1;
-	for (auto& fun : m_functions) {
-		if (fun.prototype.getName() == name) {
-			i32 score = fun.prototype.getSuitableness(argTypes, isCompileTime);
-			if (score < 0) {
-				continue;
-			}
+	for (u32 index : entry->functions) {
+		Function& fun = m_functions[index];
+		i32 score = fun.prototype.getSuitableness(argTypes, isCompileTime);
+		if (score < 0) {
+			continue;
+		}
 
-			if (result == nullptr || score < bestScore) {
-				bestScore = score;
-				result = &fun;
+		if (result == nullptr || score < bestScore) {
+			bestScore = score;
+			result = &fun;
 
-				if (score == 0) {
-					return result;
-				}
+			if (score == 0) {
+				return result;
 			}
 		}
 	}
@@ -134,8 +129,8 @@ Function* ModuleSymbolsUnit::chooseFunction(
 }
 
 Function* ModuleSymbolsUnit::chooseConstructor(
-	const std::shared_ptr<Type>& type,
-	const std::vector<std::shared_ptr<Type>>& argTypes,
+	Type* type,
+	const std::vector<Type*>& argTypes,
 	const std::vector<bool>& isCompileTime,
 	bool isImlicit
 ) {
@@ -165,26 +160,34 @@ Function* ModuleSymbolsUnit::chooseConstructor(
 
 Function* ModuleSymbolsUnit::chooseOperator(
 	const std::string& name, 
-	const std::vector<std::shared_ptr<Type>>& argTypes, 
+	const std::vector<Type*>& argTypes, 
 	const std::vector<bool>& isCompileTime,
 	bool mustReturnReference
 ) {
+	const SymbolNameEntry* entry = findName(name);
+	if (entry == nullptr) {
+		return nullptr;
+	}
+
 	Function* result = nullptr;
 	i32 bestScore = -1;
-	for (auto& fun : m_operators) {
-		if (fun.prototype.getName() == name && (!mustReturnReference || isReference(fun.prototype.getReturnType()->basicType))) {
-			i32 score = fun.prototype.getSuitableness(argTypes, isCompileTime);
-			if (score < 0) {
-				continue;
-			}
+	for (u32 index : entry->operators) {
+		Function& fun = m_operators[index];
+		if (mustReturnReference && !isReference(fun.prototype.getReturnType()->basicType)) {
+			continue;
+		}
 
-			if (result == nullptr || score < bestScore) {
-				bestScore = score;
-				result = &fun;
+		i32 score = fun.prototype.getSuitableness(argTypes, isCompileTime);
+		if (score < 0) {
+			continue;
+		}
 
-				if (score == 0) {
-					return result;
-				}
+		if (result == nullptr || score < bestScore) {
+			bestScore = score;
+			result = &fun;
+
+			if (score == 0) {
+				return result;
 			}
 		}
 	}
@@ -193,23 +196,21 @@ Function* ModuleSymbolsUnit::chooseOperator(
 }
 
 Variable* ModuleSymbolsUnit::getVariable(const std::string& name) {
-	for (auto& var : m_variables) {
-		if (var.name == name) {
-			return &var;
-		}
+	const SymbolNameEntry* entry = findName(name);
+	if (entry == nullptr || entry->variables.empty()) {
+		return nullptr;
 	}
 
-	return nullptr;
+	return &m_variables[entry->variables[0]];
 }
 
 std::shared_ptr<TypeNode> ModuleSymbolsUnit::getType(const std::string& name) {
-	for (auto& type : m_types) {
-		if (type->name == name) {
-			return type;
-		}
+	const SymbolNameEntry* entry = findName(name);
+	if (entry == nullptr || entry->types.empty()) {
+		return nullptr;
 	}
 
-	return nullptr;
+	return m_types[entry->types[0]];
 }
 
 std::vector<Variable>& ModuleSymbolsUnit::getVariables() {
@@ -240,6 +241,15 @@ bool ModuleSymbolsUnit::isEmpty() const {
 		&& m_operators.size() == 0;
 }
 
+u64 ModuleSymbolsUnit::getGeneration() {
+	return s_generation;
+}
+
+const SymbolNameEntry* ModuleSymbolsUnit::findName(const std::string& name) const {
+	auto it = m_nameIndex.find(name);
+	return it == m_nameIndex.end() ? nullptr : &it->second;
+}
+
 ModuleSymbolsUnit& ModuleSymbols::getModuleSymbolsUnit(Visibility visibility) {
 	switch (visibility) {
 		case Visibility::PRIVATE: return privateSymbols;
@@ -252,45 +262,38 @@ ModuleSymbolsUnit& ModuleSymbols::getModuleSymbolsUnit(Visibility visibility) {
 	ASSERT(false, "wrong visibility");
 }
 
-void ModuleSymbols::sortSymbolRefs() {
-	std::sort(m_symbolRefs.begin(), m_symbolRefs.end(), [](const SymbolRef& a, const SymbolRef& b) -> bool {
-		return a.tokenPos < b.tokenPos;
-	});
-}
-
 void ModuleSymbols::addType(Visibility visibility, std::shared_ptr<TypeNode> type, u64 tokenPos) {
 	ModuleSymbolsUnit& unit = getModuleSymbolsUnit(visibility);
-	m_symbolRefs.push_back(SymbolRef{ tokenPos, unit.m_types.size(), SymbolType::TYPE, visibility });
+	addSymbolRef(SymbolRef{ tokenPos, unit.m_types.size(), SymbolType::TYPE, visibility });
 	unit.addType(std::move(type));
 }
 
 void ModuleSymbols::addFunction(Visibility visibility, FunctionPrototype prototype, u64 tokenPos) {
 	ModuleSymbolsUnit& unit = getModuleSymbolsUnit(visibility);
-	m_symbolRefs.push_back(SymbolRef{ tokenPos, unit.m_functions.size(), SymbolType::FUNCTION, visibility });
+	addSymbolRef(SymbolRef{ tokenPos, unit.m_functions.size(), SymbolType::FUNCTION, visibility });
 	unit.addFunction(std::move(prototype));
 }
 
 void ModuleSymbols::addConstructor(Visibility visibility, FunctionPrototype prototype, u64 tokenPos) {
 	ModuleSymbolsUnit& unit = getModuleSymbolsUnit(visibility);
-	m_symbolRefs.push_back(SymbolRef{ tokenPos, unit.m_constructors.size(), SymbolType::CONSTRUCTOR, visibility });
+	addSymbolRef(SymbolRef{ tokenPos, unit.m_constructors.size(), SymbolType::CONSTRUCTOR, visibility });
 	unit.addConstructor(std::move(prototype));
 }
 
 void ModuleSymbols::addOperator(Visibility visibility, FunctionPrototype prototype, u64 tokenPos) {
 	ModuleSymbolsUnit& unit = getModuleSymbolsUnit(visibility);
-	m_symbolRefs.push_back(SymbolRef{ tokenPos, unit.m_operators.size(), SymbolType::OPERATOR, visibility });
+	addSymbolRef(SymbolRef{ tokenPos, unit.m_operators.size(), SymbolType::OPERATOR, visibility });
 	unit.addOperator(std::move(prototype));
 }
 
 void ModuleSymbols::addVariable(Visibility visibility, const std::string& name, VariableQualities qualities, u64 tokenPos) {
 	ModuleSymbolsUnit& unit = getModuleSymbolsUnit(visibility);
-	m_symbolRefs.push_back(SymbolRef{ tokenPos, unit.m_variables.size(), SymbolType::VARIABLE, visibility });
+	addSymbolRef(SymbolRef{ tokenPos, unit.m_variables.size(), SymbolType::VARIABLE, visibility });
 	unit.addVariable(name, nullptr, qualities, nullptr);
 }
 
 Function* ModuleSymbols::getFunction(u64 tokenPos) {
-	ASSERT(m_symbolRefs.size(), "No symbol refs");
-	SymbolRef& symbol = getSymbolRefByTokenPos(0, m_symbolRefs.size() - 1, tokenPos);
+	SymbolRef& symbol = getSymbolRefByTokenPos(tokenPos);
 	std::vector<Function>* funcsVec;
 
 	if (symbol.symType == SymbolType::FUNCTION) {
@@ -310,8 +313,7 @@ Function* ModuleSymbols::getFunction(u64 tokenPos) {
 }
 
 Variable* ModuleSymbols::getVariable(u64 tokenPos) {
-	ASSERT(m_symbolRefs.size(), "No symbol refs");
-	SymbolRef& symbol = getSymbolRefByTokenPos(0, m_symbolRefs.size() - 1, tokenPos);
+	SymbolRef& symbol = getSymbolRefByTokenPos(tokenPos);
 	auto& varsVec = getModuleSymbolsUnit(symbol.visibility).m_variables;
 
 	ASSERT(symbol.symType == SymbolType::VARIABLE, "not a variable");
@@ -321,8 +323,7 @@ Variable* ModuleSymbols::getVariable(u64 tokenPos) {
 }
 
 std::shared_ptr<TypeNode> ModuleSymbols::getType(u64 tokenPos) {
-	ASSERT(m_symbolRefs.size(), "No symbol refs");
-	SymbolRef& symbol = getSymbolRefByTokenPos(0, m_symbolRefs.size() - 1, tokenPos);
+	SymbolRef& symbol = getSymbolRefByTokenPos(tokenPos);
 	auto& typesVec = getModuleSymbolsUnit(symbol.visibility).m_types;
 
 	ASSERT(symbol.symType == SymbolType::TYPE, "not a type");
@@ -331,13 +332,22 @@ std::shared_ptr<TypeNode> ModuleSymbols::getType(u64 tokenPos) {
 	return typesVec[symbol.index];
 }
 
-SymbolRef& ModuleSymbols::getSymbolRefByTokenPos(u64 from, u64 to, u64 tokenPos) {
-	for (size_t i = from; i <= to; i++) {
-		SymbolRef& val = m_symbolRefs[i];
-		if (val.tokenPos == tokenPos) {
-			return val;
-		}
+void ModuleSymbols::addSymbolRef(SymbolRef symbol) {
+	// The table is dense: its size is bounded by the number of tokens in the module
+	if (symbol.tokenPos >= m_symbolRefIndices.size()) {
+		m_symbolRefIndices.resize(symbol.tokenPos + 1, 0);
 	}
 
-	ASSERT(false, "No such symbol");
+	// The first symbol declared at the position is the one found by the position
+	u32& refIndex = m_symbolRefIndices[symbol.tokenPos];
+	if (refIndex == 0) {
+		refIndex = u32(m_symbolRefs.size()) + 1;
+	}
+
+	m_symbolRefs.push_back(symbol);
+}
+
+SymbolRef& ModuleSymbols::getSymbolRefByTokenPos(u64 tokenPos) {
+	ASSERT(tokenPos < m_symbolRefIndices.size() && m_symbolRefIndices[tokenPos] != 0, "No such symbol");
+	return m_symbolRefs[m_symbolRefIndices[tokenPos] - 1];
 }
@@ -1,6 +1,7 @@
 #pragma once
 #include <vector>
 #include <map>
+#include <unordered_map>
 #include "Symbols/SymbolRef.h"
 #include "Symbols/Variable.h"
 #include "Symbols/Function.h"
@@ -8,6 +9,15 @@
 
 class ModuleSymbols;
 
+// Indices of all the symbols with a certain name in the lists of a ModuleSymbolsUnit
+struct SymbolNameEntry {
+	std::vector<u32> variables;
+	std::vector<u32> functions; // the overload set
+	std::vector<u32> constructors;
+	std::vector<u32> operators;
+	std::vector<u32> types;
+};
+
 class ModuleSymbolsUnit final {
 	friend class ModuleSymbols;
 
@@ -18,6 +28,12 @@ private:
 	std::vector<Function> m_operators;
 	std::vector<std::shared_ptr<TypeNode>> m_types;
 
+	// name -> indices of the symbols, maintained by the add* methods
+	std::unordered_map<std::string, SymbolNameEntry> m_nameIndex;
+
+	// Incremented whenever a symbol is added to any unit, invalidates the memoized overload resolutions
+	static u64 s_generation;
+
 public:
 	void addType(std::shared_ptr<TypeNode> type);
 	void addFunction(FunctionPrototype prototype);
@@ -30,7 +46,7 @@ public:
 
 	void addVariable(
 		const std::string& name,
-		std::shared_ptr<Type> type,
+		Type* type,
 		VariableQualities qualities,
 		std::shared_ptr<LLVMVariableManager> value
 	);
@@ -44,21 +60,21 @@ public:
 	// Finds the function with the name and exactly argTypes
 	Function* getFunction(
 		const std::string& name,
-		const std::vector<std::shared_ptr<Type>>& argTypes,
+		const std::vector<Type*>& argTypes,
 		const std::vector<bool>& isCompileTime
 	);
 
 	// Chooses the most suitable function with name for argTypes
 	Function* chooseFunction(
 		const std::string& name,
-		const std::vector<std::shared_ptr<Type>>& argTypes,
+		const std::vector<Type*>& argTypes,
 		const std::vector<bool>& isCompileTime
 	);
 
 	// Chooses the most suitable constructor of type for argTypes
 	Function* chooseConstructor(
-		const std::shared_ptr<Type>& type,
-		const std::vector<std::shared_ptr<Type>>& argTypes,
+		Type* type,
+		const std::vector<Type*>& argTypes,
 		const std::vector<bool>& isCompileTime,
 		bool isImplicit
 	);
@@ -66,7 +82,7 @@ public:
 	// Chooses the most suitable operator with operator-name for argTypes
 	Function* chooseOperator(
 		const std::string& name,
-		const std::vector<std::shared_ptr<Type>>& argTypes,
+		const std::vector<Type*>& argTypes,
 		const std::vector<bool>& isCompileTime,
 		bool mustReturnReference
 	);
@@ -81,6 +97,11 @@ public:
 	std::vector<std::shared_ptr<TypeNode>>& getTypes();
 
 	bool isEmpty() const;
+
+	static u64 getGeneration();
+
+private:
+	const SymbolNameEntry* findName(const std::string& name) const;
 };
 
 class ModuleSymbols {
@@ -88,15 +109,15 @@ private:
 	// ordered list of SymbolRefs refering to corresponding symbols in the unit
 	std::vector<SymbolRef> m_symbolRefs;
 
+	// tokenPos -> index in m_symbolRefs + 1, 0 if there is no symbol at the position
+	std::vector<u32> m_symbolRefIndices;
+
 public:
 	ModuleSymbolsUnit publicSymbols;
 	ModuleSymbolsUnit publicOnceSymbols;
 	ModuleSymbolsUnit privateSymbols;
 
 public:
-	// deprecated
-	void sortSymbolRefs();
-
 	void addType(Visibility visibility, std::shared_ptr<TypeNode> type, u64 tokenPos);
 	void addFunction(Visibility visibility, FunctionPrototype prototype, u64 tokenPos);
 	void addConstructor(Visibility visibility, FunctionPrototype prototype, u64 tokenPos);
@@ -114,7 +135,8 @@ public:
 	std::shared_ptr<TypeNode> getType(u64 tokenPos);
 
 private:
-	SymbolRef& getSymbolRefByTokenPos(u64 from, u64 to, u64 tokenPos);
+	void addSymbolRef(SymbolRef symbol);
+	SymbolRef& getSymbolRefByTokenPos(u64 tokenPos);
 
 public:
 	ModuleSymbolsUnit& getModuleSymbolsUnit(Visibility visibility);
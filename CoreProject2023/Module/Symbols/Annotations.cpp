@@ -24,6 +24,10 @@ u64 CommonQualities::getData() const {
     return m_data;
 }
 
+void CommonQualities::setData(u64 data) {
+    m_data = u8(data);
+}
+
 ModuleQualities::ModuleQualities() {
     setVisibility(Visibility::PUBLIC);
     setSafety(Safety::SAFE_ONLY);
@@ -208,4 +212,9 @@ void FunctionQualities::setFunctionKind(FunctionKind kind) {
 
 u64 FunctionQualities::getData() const {
     return m_data | (m_additionalData << 8);
+}
+
+void FunctionQualities::setData(u64 data) {
+    m_data = u8(data);
+    m_additionalData = u16(data >> 8);
 }
\ No newline at end of file
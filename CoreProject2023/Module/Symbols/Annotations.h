@@ -34,6 +34,7 @@ public:
 	void setSafety(Safety visibility);
 
 	virtual u64 getData() const;
+	virtual void setData(u64 data); // restores the qualities saved through getData
 };
 
 /*
@@ -181,4 +182,5 @@ public:
 	void setFunctionKind(FunctionKind kind);
 
 	u64 getData() const override;
+	void setData(u64 data) override;
 };
\ No newline at end of file
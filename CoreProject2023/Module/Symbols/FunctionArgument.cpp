@@ -1,7 +1,7 @@
 #include "FunctionArgument.h"
 
-Argument::Argument(std::string name, std::shared_ptr<Type> type)
-	: name(std::move(name)), type(std::move(type)) {
+Argument::Argument(std::string name, Type* type)
+	: name(std::move(name)), type(type) {
 
 }
 
@@ -4,8 +4,8 @@
 
 struct Argument {
 	std::string name;
-	std::shared_ptr<Type> type;
+	Type* type = nullptr;
 
-	Argument(std::string name, std::shared_ptr<Type> type);
+	Argument(std::string name, Type* type);
 	Argument(const Argument& other);
 };
\ No newline at end of file
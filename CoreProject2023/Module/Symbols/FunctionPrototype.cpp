@@ -1,17 +1,26 @@
 #include "FunctionPrototype.h"
+#include <unordered_set>
 #include <Utils/Defs.h>
+#include <Utils/Statistics.h>
 #include <Project/Project.h>
 #include <Module/Module.h>
 #include <Module/LLVMGlobals.h>
 
-FunctionPrototype::FunctionPrototype(const std::string& name, std::shared_ptr<Type> returnType, std::vector<Argument> args,
+STATISTIC(NumCandidatesScored, "symbols", "overload candidates scored (getSuitableness)");
+STATISTIC(NumMangledNames, "symbols", "function names mangled");
+
+// The LLVM names of all the functions, each string is stored once and never moves
+std::unordered_set<std::string> g_llvmNames;
+
+FunctionPrototype::FunctionPrototype(const std::string& name, Type* returnType, std::vector<Argument> args,
 	FunctionQualities qualities, bool isVaArgs)
-	: m_name(name), m_returnType(std::move(returnType)), m_args(std::move(args)), m_qualities(qualities), m_isVaArgs(isVaArgs) {
+	: m_name(name), m_returnType(returnType), m_args(std::move(args)), m_qualities(qualities), m_isVaArgs(isVaArgs) {
 
 }
 
 FunctionPrototype::FunctionPrototype(FunctionPrototype& other)
-	: m_name(other.m_name), m_returnType(other.m_returnType), m_qualities(other.m_qualities), m_isVaArgs(other.m_isVaArgs) {
+	: m_name(other.m_name), m_returnType(other.m_returnType), m_qualities(other.m_qualities), m_isVaArgs(other.m_isVaArgs),
+	  m_llvmName(other.m_llvmName) {
 	m_args.reserve(other.m_args.size());
 	for (auto& arg : other.m_args) {
 		m_args.push_back(arg);
@@ -19,8 +28,8 @@ FunctionPrototype::FunctionPrototype(FunctionPrototype& other)
 }
 
 FunctionPrototype::FunctionPrototype(FunctionPrototype&& other) noexcept
-	: m_name(std::move(other.m_name)), m_returnType(std::move(other.m_returnType)), m_args(std::move(other.m_args)),
-	  m_qualities(other.m_qualities), m_isVaArgs(other.m_isVaArgs) {
+	: m_name(std::move(other.m_name)), m_returnType(other.m_returnType), m_args(std::move(other.m_args)),
+	  m_qualities(other.m_qualities), m_isVaArgs(other.m_isVaArgs), m_llvmName(other.m_llvmName) {
 
 }
 
@@ -85,9 +94,11 @@ llvm::Function* FunctionPrototype::generateImportedFromOtherModule(llvm::Module&
 }
 
 i32 FunctionPrototype::getSuitableness(
-	const std::vector<std::shared_ptr<Type>>& argTypes,
+	const std::vector<Type*>& argTypes,
 	const std::vector<bool>& isCompileTime
 ) const {
+	++NumCandidatesScored;
+
 	auto isCT = [&](size_t i) -> bool {
 		if (i >= isCompileTime.size()) {
 			return false;
@@ -118,12 +129,17 @@ i32 FunctionPrototype::getSuitableness(
 	return result;
 }
 
-std::string FunctionPrototype::getLLVMName() const {
-	if (m_qualities.isManglingOn() && m_name != "main") {
-		return genMangledName();
-	} else {
+const std::string& FunctionPrototype::getLLVMName() const {
+	if (!m_qualities.isManglingOn() || m_name == "main") {
 		return m_name;
 	}
+
+	if (!m_llvmName) {
+		++NumMangledNames;
+		m_llvmName = &*g_llvmNames.insert(genMangledName()).first;
+	}
+
+	return *m_llvmName;
 }
 
 std::string FunctionPrototype::genMangledName() const {
@@ -142,6 +158,7 @@ const std::string& FunctionPrototype::getName() const {
 
 void FunctionPrototype::setName(const std::string& s) {
 	m_name = s;
+	m_llvmName = nullptr;
 }
 
 bool FunctionPrototype::isVaArgs() const {
@@ -156,16 +173,12 @@ const FunctionQualities& FunctionPrototype::getQualities() const {
 	return m_qualities;
 }
 
-std::shared_ptr<Type>& FunctionPrototype::getReturnType() {
-	return m_returnType;
-}
-
-std::shared_ptr<FunctionType> FunctionPrototype::genType() const {
+FunctionType* FunctionPrototype::genType() const {
 	return FunctionType::createType(m_returnType, genArgumentTypes(), m_isVaArgs, false);
 }
 
-std::vector<std::shared_ptr<Type>> FunctionPrototype::genArgumentTypes() const {
-	std::vector<std::shared_ptr<Type>> argTypes;
+std::vector<Type*> FunctionPrototype::genArgumentTypes() const {
+	std::vector<Type*> argTypes;
 	for (auto& arg : m_args) {
 		argTypes.push_back(arg.type);
 	}
@@ -173,14 +186,24 @@ std::vector<std::shared_ptr<Type>> FunctionPrototype::genArgumentTypes() const {
 	return argTypes;
 }
 
-std::vector<Argument>& FunctionPrototype::args() {
+const std::vector<Argument>& FunctionPrototype::args() const {
 	return m_args;
 }
 
-const std::shared_ptr<Type>& FunctionPrototype::getReturnType() const {
+void FunctionPrototype::setArgs(std::vector<Argument> args) {
+	m_args = std::move(args);
+	m_llvmName = nullptr;
+}
+
+Type* FunctionPrototype::getReturnType() const {
 	return m_returnType;
 }
 
+void FunctionPrototype::setReturnType(Type* returnType) {
+	m_returnType = returnType;
+	m_llvmName = nullptr;
+}
+
 bool FunctionPrototype::isUsingThisAsArgument() const {
 	return m_qualities.isMethod() || m_qualities.getFunctionKind() == FunctionKind::DESTRUCTOR;
 }
@@ -8,7 +8,7 @@ class FunctionPrototype final {
 public:
 	FunctionPrototype(
 		const std::string& name, 
-		std::shared_ptr<Type> returnType, 
+		Type* returnType, 
 		std::vector<Argument> args, 
 		FunctionQualities qualities, 
 		bool isVaArgs
@@ -24,12 +24,13 @@ public:
 	// Otherwise - the score showing for how much is the function suitable, the lesser the better
 	// A negative value means that the function is not suitable for this arguments at all
 	i32 getSuitableness(
-		const std::vector<std::shared_ptr<Type>>& argTypes,
+		const std::vector<Type*>& argTypes,
 		const std::vector<bool>& isCompileTime
 	) const;
 
 	// Returns mangled name or just name if the function has @nomangle annotation
-	std::string getLLVMName() const;
+	// The name is computed once and recomputed after the name, return type or arguments are set
+	const std::string& getLLVMName() const;
 
 	std::string genMangledName() const;
 
@@ -40,13 +41,15 @@ public:
 	void setVaArgs(bool isVaArgs);
 
 	const FunctionQualities& getQualities() const;
-	std::shared_ptr<Type>& getReturnType();
 
-	std::shared_ptr<FunctionType> genType() const;
+	FunctionType* genType() const;
 
-	std::vector<std::shared_ptr<Type>> genArgumentTypes() const;
-	std::vector<Argument>& args();
-	const std::shared_ptr<Type>& getReturnType() const;
+	std::vector<Type*> genArgumentTypes() const;
+	const std::vector<Argument>& args() const;
+	void setArgs(std::vector<Argument> args);
+
+	Type* getReturnType() const;
+	void setReturnType(Type* returnType);
 
 	// True for a method and destructor
 	bool isUsingThisAsArgument() const;
@@ -60,8 +63,10 @@ public:
 
 private:
 	std::string m_name;
-	std::shared_ptr<Type> m_returnType;
+	Type* m_returnType = nullptr;
 	std::vector<Argument> m_args;
 	FunctionQualities m_qualities;
 	bool m_isVaArgs;
+
+	mutable const std::string* m_llvmName = nullptr; // interned, set by the first getLLVMName()
 };
\ No newline at end of file
@@ -5,7 +5,7 @@
 #include <Module/LLVMUtils.h>
 
 void LLVMFunctionManager::setInitialValue(llvm::Function* funcValue) {
-    m_functionValues[g_module->getPath()] = funcValue;
+    getValueForModule(g_module->getId()) = funcValue;
     m_originalValue = funcValue;
 }
 
@@ -14,13 +14,22 @@ llvm::Function* LLVMFunctionManager::getFunctionValueForCurrentModule(FunctionPr
         return m_originalValue;
     }
 
-    if (!m_functionValues.contains(g_module->getPath())) {
-        m_functionValues[g_module->getPath()] = func->generateImportedFromOtherModule(g_module->getLLVMModule());
+    llvm::Function*& value = getValueForModule(g_module->getId());
+    if (!value) {
+        value = func->generateImportedFromOtherModule(g_module->getLLVMModule());
     }
 
-    return m_functionValues[g_module->getPath()];
+    return value;
 }
 
 llvm::Function* LLVMFunctionManager::getOriginalValue() {
     return m_originalValue;
 }
+
+llvm::Function*& LLVMFunctionManager::getValueForModule(u32 moduleId) {
+    if (moduleId >= m_functionValues.size()) {
+        m_functionValues.resize(moduleId + 1, nullptr);
+    }
+
+    return m_functionValues[moduleId];
+}
\ No newline at end of file
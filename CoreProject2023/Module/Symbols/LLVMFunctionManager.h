@@ -1,13 +1,14 @@
 #pragma once
-#include <map>
+#include <llvm/ADT/SmallVector.h>
 #include <llvm/IR/Function.h>
+#include <Utils/Defs.h>
 
 class FunctionPrototype;
 
 // Allows to get get the llvm::Function* of a function
 // Returns the original value for the module it is located in and the external function for other modules
 class LLVMFunctionManager {
-	std::map<std::string, llvm::Function*> m_functionValues;
+	llvm::SmallVector<llvm::Function*, 4> m_functionValues; // module id -> the function's value, nullptr if not declared there
 	llvm::Function* m_originalValue = nullptr;
 
 public:
@@ -17,4 +18,7 @@ public:
 	llvm::Function* getFunctionValueForCurrentModule(FunctionPrototype* func);
 
 	llvm::Function* getOriginalValue();
+
+private:
+	llvm::Function*& getValueForModule(u32 moduleId);
 };
\ No newline at end of file
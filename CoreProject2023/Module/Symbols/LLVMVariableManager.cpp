@@ -5,7 +5,7 @@
 #include <Module/LLVMUtils.h>
 
 void LLVMVariableManager::setInitialValue(llvm::Value* varValue) {
-	m_variableValues[g_module->getPath()] = varValue;
+	getValueForModule(g_module->getId()) = varValue;
 	m_originalValue = varValue;
 }
 
@@ -14,13 +14,22 @@ llvm::Value* LLVMVariableManager::getVariableValueForCurrentModule(Variable* var
 		return m_originalValue;
 	}
 
-	if (!m_variableValues.contains(g_module->getPath())) {
-		m_variableValues[g_module->getPath()] = llvm_utils::addGlobalVariableFromOtherModule(*var, g_module->getLLVMModule());
+	llvm::Value*& value = getValueForModule(g_module->getId());
+	if (!value) {
+		value = llvm_utils::addGlobalVariableFromOtherModule(*var, g_module->getLLVMModule());
 	}
 
-	return m_variableValues[g_module->getPath()];
+	return value;
 }
 
 llvm::Value* LLVMVariableManager::getOriginalValue() {
 	return m_originalValue;
 }
+
+llvm::Value*& LLVMVariableManager::getValueForModule(u32 moduleId) {
+	if (moduleId >= m_variableValues.size()) {
+		m_variableValues.resize(moduleId + 1, nullptr);
+	}
+
+	return m_variableValues[moduleId];
+}
\ No newline at end of file
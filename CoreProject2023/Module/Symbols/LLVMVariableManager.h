@@ -1,13 +1,14 @@
 #pragma once
-#include <map>
+#include <llvm/ADT/SmallVector.h>
 #include <llvm/IR/Value.h>
+#include <Utils/Defs.h>
 
 struct Variable;
 
 // Allows to get get the llvm::Value* of a global object as in the current module
 // Returns the original value for the module it is located in and the external value (variable/function) for other modules
 class LLVMVariableManager {
-	std::map<std::string, llvm::Value*> m_variableValues;
+	llvm::SmallVector<llvm::Value*, 4> m_variableValues; // module id -> the variable's value, nullptr if not declared there
 	llvm::Value* m_originalValue = nullptr;
 
 public:
@@ -17,4 +18,7 @@ public:
 	llvm::Value* getVariableValueForCurrentModule(Variable* var);
 
 	llvm::Value* getOriginalValue();
+
+private:
+	llvm::Value*& getValueForModule(u32 moduleId);
 };
\ No newline at end of file
@@ -2,19 +2,23 @@
 #include "TypeNode.h"
 #include <Module/Module.h>
 #include <Module/LLVMGlobals.h>
+#include <unordered_map>
+#include <llvm/ADT/Hashing.h>
+#include <Utils/Statistics.h>
 
-std::vector<std::vector<std::shared_ptr<Type>>> typeInstancesInit() {
-	std::vector<std::vector<std::shared_ptr<Type>>> result;
-	for (u8 i = 0; i < u8(BasicType::UNKNOWN); i++) {
-		result.push_back({ });
+STATISTIC(NumTypeRequests, "types", "type instances requested (createType)");
+STATISTIC(NumTypesCreated, "types", "type instances created");
+
+struct TypeStructureHash {
+	size_t operator()(const TypeStructure& structure) const {
+		return llvm::hash_combine_range(structure.begin(), structure.end());
 	}
+};
 
-	return result;
-}
+std::unordered_map<TypeStructure, Type*, TypeStructureHash> g_typeInstancesByStructure;
 
-std::vector<std::vector<std::shared_ptr<Type>>> Type::s_typeInstances[2] = {
-	typeInstancesInit(), typeInstancesInit()
-};
+std::vector<std::unique_ptr<Type>> Type::s_typeInstances;
+Type* Type::s_basicTypeInstances[2][u8(BasicType::UNKNOWN)] = { };
 
 Type::Type()
 	: Type(BasicType::NO_TYPE, false) {
@@ -22,24 +26,21 @@ Type::Type()
 }
 
 Type::Type(BasicType basic, bool isConst)
-	: basicType(basic), isConst(isConst), m_hash(s_typeInstances[isConst][u8(basic)].size()) {
+	: basicType(basic), isConst(isConst) {
 	if (isUnsafe(basic, isConst)) {
 		safety = Safety::UNSAFE;
 	}
 }
 
-std::shared_ptr<Type> Type::copy(i32 makeConst) const {
+Type* Type::copy(i32 makeConst) const {
 	return createType(basicType, makeConst == -1 ? isConst : makeConst);
 }
 
-bool Type::equals(const std::shared_ptr<Type>& other) const {
-	if (basicType != other->basicType || isConst != other->isConst)
-		return false;
-
-	return m_hash == other->m_hash;
+bool Type::equals(Type* other) const {
+	return this == other;
 }
 
-i32 Type::equalsOrLessConstantThan(const std::shared_ptr<Type>& other) const {
+i32 Type::equalsOrLessConstantThan(Type* other) const {
 	if (basicType != other->basicType) {
 		return -4097;
 	}
@@ -128,11 +129,11 @@ u64 Type::getAlignment() const {
 	return (this->getBitSize() + 7) / 8;
 }
 
-u64 Type::getHash() const {
-	return m_hash;
+u64 Type::getId() const {
+	return m_id;
 }
 
-std::shared_ptr<Type>& Type::dereference(std::shared_ptr<Type>& type) {
+Type* Type::dereference(Type* type) {
 	if (isReference(type->basicType)) {
 		return dereference(type->asPointerType()->elementType);
 	}
@@ -140,33 +141,39 @@ std::shared_ptr<Type>& Type::dereference(std::shared_ptr<Type>& type) {
 	return type;
 }
 
-const std::shared_ptr<Type>& Type::dereference(const std::shared_ptr<Type>& type) {
-	if (isReference(type->basicType)) {
-		return dereference(type->asPointerType()->elementType);
+Type* Type::createType(BasicType type, bool isConst) {
+	++NumTypeRequests;
+	Type*& instance = s_basicTypeInstances[isConst][u8(type)];
+	if (!instance) {
+		instance = addInstance(std::make_unique<Type>(type, isConst));
 	}
 
-	return type;
+	return instance;
 }
 
-std::shared_ptr<Type> Type::createType(BasicType type, bool isConst) {
-	auto& vec = s_typeInstances[isConst][u8(type)];
-	if (vec.size() == 0) {
-		vec.push_back(std::make_shared<Type>(type, isConst));
-	}
+Type*& Type::findInstance(TypeStructure structure) {
+	++NumTypeRequests;
+	return g_typeInstancesByStructure[std::move(structure)];
+}
+
+Type* Type::addInstance(std::unique_ptr<Type> type) {
+	++NumTypesCreated;
+	type->m_id = s_typeInstances.size();
+	s_typeInstances.push_back(std::move(type));
 
-	return vec[0];
+	return s_typeInstances.back().get();
 }
 
-ArrayType::ArrayType(std::shared_ptr<Type> elementType, u64 size, bool isConst)
-	: elementType(std::move(elementType)), size(size), Type(BasicType::ARRAY, isConst) {
+ArrayType::ArrayType(Type* elementType, u64 size, bool isConst)
+	: elementType(elementType), size(size), Type(BasicType::ARRAY, isConst) {
 	safety = this->elementType->safety;
 }
 
-std::shared_ptr<Type> ArrayType::copy(i32 makeConst) const {
+Type* ArrayType::copy(i32 makeConst) const {
 	return ArrayType::createType(elementType->copy(), size, makeConst == -1 ? isConst : makeConst);
 }
 
-i32 ArrayType::equalsOrLessConstantThan(const std::shared_ptr<Type>& other) const {
+i32 ArrayType::equalsOrLessConstantThan(Type* other) const {
 	if (other->basicType != BasicType::ARRAY) {
 		return -4097;
 	}
@@ -208,22 +215,17 @@ u64 ArrayType::getBitSize() const {
 	return 64;
 }
 
-std::shared_ptr<ArrayType> ArrayType::createType(std::shared_ptr<Type> elementType, u64 size, bool isConst) {
-	auto& vec = s_typeInstances[isConst][u8(BasicType::ARRAY)];
-	for (auto& type : vec) {
-		if (type->isConst == isConst 
-			&& type->asArrayType()->size == size 
-			&& type->asArrayType()->elementType->equals(elementType)) {
-			return std::static_pointer_cast<ArrayType, Type>(type);
-		}
+ArrayType* ArrayType::createType(Type* elementType, u64 size, bool isConst) {
+	Type*& instance = findInstance({ u64(BasicType::ARRAY), isConst, size, elementType->getId() });
+	if (!instance) {
+		instance = addInstance(std::make_unique<ArrayType>(elementType, size, isConst));
 	}
 
-	vec.push_back(std::make_shared<ArrayType>(std::move(elementType), size, isConst));
-	return std::static_pointer_cast<ArrayType, Type>(vec.back());
+	return (ArrayType*)instance;
 }
 
-PointerType::PointerType(BasicType basicType, std::shared_ptr<Type> elementType, bool isConst)
-	: elementType(std::move(elementType)), Type(basicType, isConst) {
+PointerType::PointerType(BasicType basicType, Type* elementType, bool isConst)
+	: elementType(elementType), Type(basicType, isConst) {
 	ASSERT(basicType >= BasicType::DYN_ARRAY && basicType <= BasicType::OPTIONAL, "wrong basic type");
 	
 	if (isReference(this->basicType) && this->elementType->isConst) {
@@ -242,11 +244,11 @@ PointerType::PointerType(BasicType basicType, std::shared_ptr<Type> elementType,
 	}
 }
 
-std::shared_ptr<Type> PointerType::copy(i32 makeConst) const {
+Type* PointerType::copy(i32 makeConst) const {
 	return PointerType::createType(basicType, elementType->copy(), makeConst == -1 ? isConst : makeConst);
 }
 
-i32 PointerType::equalsOrLessConstantThan(const std::shared_ptr<Type>& other) const {
+i32 PointerType::equalsOrLessConstantThan(Type* other) const {
 	if (basicType != other->basicType) {
 		return -4097;
 	}
@@ -314,26 +316,26 @@ u64 PointerType::getBitSize() const {
 	return Type::getBitSize();
 }
 
-std::shared_ptr<PointerType> PointerType::createType(BasicType basicType, std::shared_ptr<Type> elementType, bool isConst) {
-	auto& vec = s_typeInstances[isConst][u8(basicType)];
-	for (auto& type : vec) {
-		if (type->isConst == isConst
-			&& type->asPointerType()->elementType->equals(elementType)) {
-			return std::static_pointer_cast<PointerType, Type>(type);
-		}
+PointerType* PointerType::createType(BasicType basicType, Type* elementType, bool isConst) {
+	if (isReference(basicType) && elementType->isConst) {
+		isConst = true; // as in the constructor
+	}
+
+	Type*& instance = findInstance({ u64(basicType), isConst, elementType->getId() });
+	if (!instance) {
+		instance = addInstance(std::make_unique<PointerType>(basicType, elementType, isConst));
 	}
 
-	vec.push_back(std::make_shared<PointerType>(basicType, std::move(elementType), isConst));
-	return std::static_pointer_cast<PointerType, Type>(vec.back());
+	return (PointerType*)instance;
 }
 
-TupleType::TupleType(std::vector<std::shared_ptr<Type>> subTypes, bool isConst)
+TupleType::TupleType(std::vector<Type*> subTypes, bool isConst)
 	: subTypes(std::move(subTypes)), Type(BasicType::TUPLE, isConst) {
 	ASSERT(this->subTypes.size(), "tuple cannot be empty");
 }
 
-std::shared_ptr<Type> TupleType::copy(i32 makeConst) const {
-	std::vector<std::shared_ptr<Type>> subTypesCopy;
+Type* TupleType::copy(i32 makeConst) const {
+	std::vector<Type*> subTypesCopy;
 	subTypesCopy.reserve(subTypes.size());
 	for (auto& subType : subTypes) {
 		subTypesCopy.push_back(subType->copy());
@@ -342,7 +344,7 @@ std::shared_ptr<Type> TupleType::copy(i32 makeConst) const {
 	return TupleType::createType(std::move(subTypesCopy), makeConst == -1 ? isConst : makeConst);
 }
 
-i32 TupleType::equalsOrLessConstantThan(const std::shared_ptr<Type>& other) const {
+i32 TupleType::equalsOrLessConstantThan(Type* other) const {
 	if (basicType != other->basicType) {
 		return -4097;
 	}
@@ -368,7 +370,7 @@ i32 TupleType::equalsOrLessConstantThan(const std::shared_ptr<Type>& other) cons
 	return value + (other->isConst ? 1 : 0);
 }
 
-bool TupleType::isEquivalentTo(std::vector<std::shared_ptr<Type>>& types) {
+bool TupleType::isEquivalentTo(std::vector<Type*>& types) {
 	if (subTypes.size() != types.size()) {
 		return false;
 	}
@@ -421,33 +423,27 @@ u64 TupleType::getBitSize() const {
 	return result;
 }
 
-std::shared_ptr<TupleType> TupleType::createType(std::vector<std::shared_ptr<Type>> subTypes, bool isConst) {
-	auto& vec = s_typeInstances[isConst][u8(BasicType::TUPLE)];
-	for (auto& type : vec) {
-		if (type->isConst == isConst
-			&& type->asTupleType()->subTypes.size() == subTypes.size()) {
-			for (size_t i = 0; i < subTypes.size(); i++) {
-				if (!subTypes[i]->equals(type->asTupleType()->subTypes[i])) {
-					goto cycle_continue;
-				}
-			}
+TupleType* TupleType::createType(std::vector<Type*> subTypes, bool isConst) {
+	TypeStructure structure = { u64(BasicType::TUPLE), isConst };
+	for (Type* subType : subTypes) {
+		structure.push_back(subType->getId());
+	}
 
-			return std::static_pointer_cast<TupleType, Type>(type);
-		cycle_continue: (void)0;
-		}
+	Type*& instance = findInstance(std::move(structure));
+	if (!instance) {
+		instance = addInstance(std::make_unique<TupleType>(std::move(subTypes), isConst));
 	}
 
-	vec.push_back(std::make_shared<TupleType>(std::move(subTypes), isConst));
-	return std::static_pointer_cast<TupleType, Type>(vec.back());
+	return (TupleType*)instance;
 }
 
 FunctionType::FunctionType(
-	std::shared_ptr<Type> returnType, 
-	std::vector<std::shared_ptr<Type>> argTypes, 
+	Type* returnType, 
+	std::vector<Type*> argTypes, 
 	bool isVaArgs, 
 	bool isConst
 ) : 
-	returnType(std::move(returnType)), 
+	returnType(returnType), 
 	argTypes(std::move(argTypes)), 
 	isVaArgs(isVaArgs), 
 	Type(BasicType::FUNCTION, isConst) {
@@ -462,11 +458,11 @@ FunctionType::FunctionType(
 	}
 }
 
-std::shared_ptr<Type> FunctionType::copy(i32 makeConst) const {
-	std::vector<std::shared_ptr<Type>> argTypesCopy;
+Type* FunctionType::copy(i32 makeConst) const {
+	std::vector<Type*> argTypesCopy;
 	argTypesCopy.reserve(argTypes.size());
 	for (auto& argType : argTypes) {
-		argTypesCopy.push_back(std::shared_ptr<Type>(argType->copy()));
+		argTypesCopy.push_back(argType->copy());
 	}
 
 	return FunctionType::createType(
@@ -477,7 +473,7 @@ std::shared_ptr<Type> FunctionType::copy(i32 makeConst) const {
 	);
 }
 
-i32 FunctionType::equalsOrLessConstantThan(const std::shared_ptr<Type>& other) const {
+i32 FunctionType::equalsOrLessConstantThan(Type* other) const {
 	if (basicType != other->basicType) {
 		return -4097;
 	}
@@ -559,31 +555,23 @@ u64 FunctionType::getBitSize() const {
 	return 64; // pointer
 }
 
-std::shared_ptr<FunctionType> FunctionType::createType(
-	std::shared_ptr<Type> returnType, 
-	std::vector<std::shared_ptr<Type>> argTypes,
+FunctionType* FunctionType::createType(
+	Type* returnType, 
+	std::vector<Type*> argTypes,
 	bool isVaArgs, 
 	bool isConst
 ) {
-	auto& vec = s_typeInstances[isConst][u8(BasicType::FUNCTION)];
-	for (auto& type : vec) {
-		if (type->isConst == isConst
-			&& type->asFunctionType()->isVaArgs == isVaArgs
-			&& type->asFunctionType()->argTypes.size() == argTypes.size()
-			&& type->asFunctionType()->returnType->equals(returnType)) {
-			for (size_t i = 0; i < argTypes.size(); i++) {
-				if (!argTypes[i]->equals(type->asFunctionType()->argTypes[i])) {
-					goto cycle_continue;
-				}
-			}
+	TypeStructure structure = { u64(BasicType::FUNCTION), isConst, isVaArgs, returnType->getId() };
+	for (Type* argType : argTypes) {
+		structure.push_back(argType->getId());
+	}
 
-			return std::static_pointer_cast<FunctionType, Type>(type);
-		cycle_continue: (void)0;
-		}
+	Type*& instance = findInstance(std::move(structure));
+	if (!instance) {
+		instance = addInstance(std::make_unique<FunctionType>(returnType, std::move(argTypes), isVaArgs, isConst));
 	}
 
-	vec.push_back(std::make_shared<FunctionType>(std::move(returnType), std::move(argTypes), isVaArgs, isConst));
-	return std::static_pointer_cast<FunctionType, Type>(vec.back());
+	return (FunctionType*)instance;
 }
 
 
@@ -592,11 +580,11 @@ TypeNodeType::TypeNodeType(std::shared_ptr<TypeNode> node, bool isConst)
 	safety = this->node->qualities.getSafety();
 }
 
-std::shared_ptr<Type> TypeNodeType::copy(i32 makeConst) const {
+Type* TypeNodeType::copy(i32 makeConst) const {
 	return TypeNodeType::createType(node, makeConst == -1 ? isConst : makeConst);
 }
 
-i32 TypeNodeType::equalsOrLessConstantThan(const std::shared_ptr<Type>& other) const {
+i32 TypeNodeType::equalsOrLessConstantThan(Type* other) const {
 	if (basicType != other->basicType) {
 		return -4097;
 	}
@@ -630,21 +618,17 @@ u64 TypeNodeType::getBitSize() const {
 	return node->type->getBitSize();
 }
 
-std::shared_ptr<TypeNodeType> TypeNodeType::createType(std::shared_ptr<TypeNode> node, bool isConst) {
-	auto& vec = s_typeInstances[isConst][u8(BasicType::TYPE_NODE)];
-	for (auto& type : vec) {
-		if (type->isConst == isConst
-			&& type->asTypeNodeType()->node == node) {
-			return std::static_pointer_cast<TypeNodeType, Type>(type);
-		}
+TypeNodeType* TypeNodeType::createType(std::shared_ptr<TypeNode> node, bool isConst) {
+	Type*& instance = findInstance({ u64(BasicType::TYPE_NODE), isConst, u64(uintptr_t(node.get())) });
+	if (!instance) {
+		instance = addInstance(std::make_unique<TypeNodeType>(std::move(node), isConst));
 	}
 
-	vec.push_back(std::make_shared<TypeNodeType>(std::move(node), isConst));
-	return std::static_pointer_cast<TypeNodeType, Type>(vec.back());
+	return (TypeNodeType*)instance;
 }
 
 
-StructType::StructType(std::vector<std::shared_ptr<Type>> fieldTypes, bool isConst)
+StructType::StructType(std::vector<Type*> fieldTypes, bool isConst)
 	: fieldTypes(std::move(fieldTypes)), Type(BasicType::STRUCT, isConst) {
 	for (auto& fieldType : this->fieldTypes) {
 		if (fieldType->safety == Safety::UNSAFE) {
@@ -653,8 +637,8 @@ StructType::StructType(std::vector<std::shared_ptr<Type>> fieldTypes, bool isCon
 	}
 }
 
-std::shared_ptr<Type> StructType::copy(i32 makeConst) const {
-	std::vector<std::shared_ptr<Type>> fieldTypesCopy;
+Type* StructType::copy(i32 makeConst) const {
+	std::vector<Type*> fieldTypesCopy;
 	fieldTypesCopy.reserve(fieldTypes.size());
 	for (auto& subType : fieldTypes) {
 		fieldTypesCopy.push_back(subType->copy());
@@ -663,7 +647,7 @@ std::shared_ptr<Type> StructType::copy(i32 makeConst) const {
 	return StructType::createType(std::move(fieldTypesCopy), makeConst == -1 ? isConst : makeConst);
 }
 
-i32 StructType::equalsOrLessConstantThan(const std::shared_ptr<Type>& other) const {
+i32 StructType::equalsOrLessConstantThan(Type* other) const {
 	if (basicType != other->basicType) {
 		return -4097;
 	}
@@ -689,7 +673,7 @@ i32 StructType::equalsOrLessConstantThan(const std::shared_ptr<Type>& other) con
 	return value + (other->isConst ? 1 : 0);
 }
 
-bool StructType::isEquivalentTo(std::vector<std::shared_ptr<Type>>& types) {
+bool StructType::isEquivalentTo(std::vector<Type*>& types) {
 	if (fieldTypes.size() != types.size()) {
 		return false;
 	}
@@ -741,31 +725,25 @@ u64 StructType::getBitSize() const {
 	return result;
 }
 
-std::shared_ptr<StructType> StructType::createType(std::vector<std::shared_ptr<Type>> fieldTypes, bool isConst) {
-	auto& vec = s_typeInstances[isConst][u8(BasicType::STRUCT)];
-	for (auto& type : vec) {
-		if (type->isConst == isConst
-			&& type->asStructType()->fieldTypes.size() == fieldTypes.size()) {
-			for (size_t i = 0; i < fieldTypes.size(); i++) {
-				if (!fieldTypes[i]->equals(type->asStructType()->fieldTypes[i])) {
-					goto cycle_continue;
-				}
-			}
+StructType* StructType::createType(std::vector<Type*> fieldTypes, bool isConst) {
+	TypeStructure structure = { u64(BasicType::STRUCT), isConst };
+	for (Type* fieldType : fieldTypes) {
+		structure.push_back(fieldType->getId());
+	}
 
-			return std::static_pointer_cast<StructType, Type>(type);
-		cycle_continue: (void)0;
-		}
+	Type*& instance = findInstance(std::move(structure));
+	if (!instance) {
+		instance = addInstance(std::make_unique<StructType>(std::move(fieldTypes), isConst));
 	}
 
-	vec.push_back(std::make_shared<StructType>(std::move(fieldTypes), isConst));
-	return std::static_pointer_cast<StructType, Type>(vec.back());
+	return (StructType*)instance;
 }
 
 
 
 bool isImplicitlyConverible(
-	const std::shared_ptr<Type>& from, 
-	const std::shared_ptr<Type>& to, 
+	Type* from, 
+	Type* to, 
 	bool isFromCompileTime
 ) {
 	if (from->equalsOrLessConstantThan(to) >= 0) {
@@ -793,7 +771,7 @@ bool isImplicitlyConverible(
 	}
 
 	if (bto == BasicType::XVAL_REFERENCE) {
-		const std::shared_ptr<Type>& nextFrom = isReference(bfrom) ?
+		Type* nextFrom = isReference(bfrom) ?
 			from->asPointerType()->elementType
 			: from;
 		return isImplicitlyConverible(nextFrom, to->asPointerType()->elementType);
@@ -867,7 +845,7 @@ bool isImplicitlyConverible(
 	return false;
 }
 
-bool isExplicitlyConverible(const std::shared_ptr<Type>& from, const std::shared_ptr<Type>& to) {
+bool isExplicitlyConverible(Type* from, Type* to) {
 	if (isImplicitlyConverible(from, to, true)) { // true because anything convertible in ct is convertible explicitly
 		return true;
 	}
@@ -922,8 +900,8 @@ bool isExplicitlyConverible(const std::shared_ptr<Type>& from, const std::shared
 }
 
 i32 evaluateConvertibility(
-	const std::shared_ptr<Type>& from,
-	const std::shared_ptr<Type>& to,
+	Type* from,
+	Type* to,
 	bool isFromCompileTime
 ) {
 	BasicType bfrom = from->basicType;
@@ -973,9 +951,9 @@ i32 evaluateConvertibility(
 	return -1;
 }
 
-std::shared_ptr<Type> findCommonType(
-	const std::shared_ptr<Type>& first, 
-	const std::shared_ptr<Type>& second,
+Type* findCommonType(
+	Type* first, 
+	Type* second,
 	bool isFirstCompileTime, 
 	bool isSecondCompileTime
 ) {
@@ -1,6 +1,8 @@
 #pragma once
 #include <string>
 #include <vector>
+#include <memory>
+#include <llvm/ADT/SmallVector.h>
 #include <llvm/IR/Type.h>
 #include <llvm/IR/DerivedTypes.h>
 #include "Annotations.h"
@@ -15,14 +17,20 @@ class FunctionType;
 class TypeNodeType;
 class StructType;
 
-// Any type is created in a single instance and never changed
+// Any type is created in a single instance and never changed or destroyed,
+// so the types are passed as plain pointers and equal types are the same pointer.
+// The instances are found by the structure of the type (hash-consing), see createType.
+
+// Basic type, constness, parameters of the type and ids of the contained types
+using TypeStructure = llvm::SmallVector<u64, 4>;
 
 class Type {
 protected:
-	static std::vector<std::vector<std::shared_ptr<Type>>> s_typeInstances[2]; // [isConst][basicType][hash]
+	static std::vector<std::unique_ptr<Type>> s_typeInstances; // the id of a type is its index
+	static Type* s_basicTypeInstances[2][u8(BasicType::UNKNOWN)]; // [isConst][basicType]
 
 protected:
-	u64 m_hash = 0; // unique to each Type with a certain constness and basic type, the index of the type in instances
+	u64 m_id = 0;
 
 public:
 	const BasicType basicType;
@@ -34,12 +42,12 @@ public:
 	Type(BasicType basic, bool isConst = false);
 
 	// -1 = not change, 0 = set to false, 1 = set to true
-	virtual std::shared_ptr<Type> copy(i32 makeConst = -1) const;
+	virtual Type* copy(i32 makeConst = -1) const;
 
-	bool equals(const std::shared_ptr<Type>& other) const;
+	bool equals(Type* other) const;
 
 	// < 0 if not equal, < -4096 if not equal at all (not equal not considering constantness)
-	virtual i32 equalsOrLessConstantThan(const std::shared_ptr<Type>& other) const;
+	virtual i32 equalsOrLessConstantThan(Type* other) const;
 
 	// returns this as a corresponding type is it is such (according to the basicType) and nullptr otherwise
 	ArrayType* asArrayType();
@@ -55,35 +63,39 @@ public:
 
 	virtual u64 getBitSize() const;
 	u64 getAlignment() const;
-	u64 getHash() const;
+	u64 getId() const;
 
 public:
 	// returns contained type for references, or returns the argument
-	static std::shared_ptr<Type>& dereference(std::shared_ptr<Type>& type);
-	static const std::shared_ptr<Type>& dereference(const std::shared_ptr<Type>& type);
+	static Type* dereference(Type* type);
 
 public:
 	// To be used instead of constructor
-	static std::shared_ptr<Type> createType(BasicType type, bool isConst = false);
+	static Type* createType(BasicType type, bool isConst = false);
+
+protected:
+	// The slot of the type with the structure, nullptr if there is no such type yet
+	static Type*& findInstance(TypeStructure structure);
+	static Type* addInstance(std::unique_ptr<Type> type);
 };
 
 
 class ArrayType final : public Type {
 public:
-	std::shared_ptr<Type> elementType;
+	Type* elementType = nullptr;
 	u64 size;
 
 public:
 	ArrayType(
-		std::shared_ptr<Type> elementType, 
+		Type* elementType, 
 		u64 size, 
 		bool isConst = false
 	);
 
 	// -1 = not change, 0 = set to false, 1 = set to true
-	virtual std::shared_ptr<Type> copy(i32 makeConst = -1) const override;
+	virtual Type* copy(i32 makeConst = -1) const override;
 
-	i32 equalsOrLessConstantThan(const std::shared_ptr<Type>& other) const override; // < 0 if not equal, < -4096 if not equal at all
+	i32 equalsOrLessConstantThan(Type* other) const override; // < 0 if not equal, < -4096 if not equal at all
 
 	llvm::ArrayType* to_llvmArrayType() const;
 	llvm::Type* to_llvm() const override;
@@ -93,8 +105,8 @@ public:
 	u64 getBitSize() const override;
 
 public:
-	static std::shared_ptr<ArrayType> createType(
-		std::shared_ptr<Type> elementType,
+	static ArrayType* createType(
+		Type* elementType,
 		u64 size,
 		bool isConst = false
 	);
@@ -104,19 +116,19 @@ public:
 // Dynamic array, pointer, references, optional
 class PointerType final : public Type {
 public:
-	std::shared_ptr<Type> elementType;
+	Type* elementType = nullptr;
 
 public:
 	PointerType(
 		BasicType basicType, 
-		std::shared_ptr<Type> elementType, 
+		Type* elementType, 
 		bool isConst = false
 	);
 
 	// -1 = not change, 0 = set to false, 1 = set to true
-	virtual std::shared_ptr<Type> copy(i32 makeConst = -1) const override;
+	virtual Type* copy(i32 makeConst = -1) const override;
 
-	i32 equalsOrLessConstantThan(const std::shared_ptr<Type>& other) const override; // < 0 if not equal, < -4096 if not equal at all
+	i32 equalsOrLessConstantThan(Type* other) const override; // < 0 if not equal, < -4096 if not equal at all
 
 	llvm::Type* to_llvm() const override;
 	std::string toString() const override;
@@ -125,9 +137,9 @@ public:
 	u64 getBitSize() const override;
 
 public:
-	static std::shared_ptr<PointerType> createType(
+	static PointerType* createType(
 		BasicType basicType,
-		std::shared_ptr<Type> elementType,
+		Type* elementType,
 		bool isConst = false
 	);
 };
@@ -135,20 +147,20 @@ public:
 
 class TupleType final : public Type {
 public:
-	std::vector<std::shared_ptr<Type>> subTypes;
+	std::vector<Type*> subTypes;
 
 public:
 	TupleType(
-		std::vector<std::shared_ptr<Type>> subTypes, 
+		std::vector<Type*> subTypes, 
 		bool isConst = false
 	);
 
 	// -1 = not change, 0 = set to false, 1 = set to true
-	virtual std::shared_ptr<Type> copy(i32 makeConst = -1) const override;
+	virtual Type* copy(i32 makeConst = -1) const override;
 
-	i32 equalsOrLessConstantThan(const std::shared_ptr<Type>& other) const override; // < 0 if not equal, < -4096 if not equal at all
+	i32 equalsOrLessConstantThan(Type* other) const override; // < 0 if not equal, < -4096 if not equal at all
 
-	bool isEquivalentTo(std::vector<std::shared_ptr<Type>>& types);
+	bool isEquivalentTo(std::vector<Type*>& types);
 
 	llvm::Type* to_llvm() const override;
 	std::string toString() const override;
@@ -157,8 +169,8 @@ public:
 	u64 getBitSize() const override;
 
 public:
-	static std::shared_ptr<TupleType> createType(
-		std::vector<std::shared_ptr<Type>> subTypes,
+	static TupleType* createType(
+		std::vector<Type*> subTypes,
 		bool isConst = false
 	);
 };
@@ -166,22 +178,22 @@ public:
 
 class FunctionType final : public Type {
 public:
-	std::shared_ptr<Type> returnType;
-	std::vector<std::shared_ptr<Type>> argTypes;
+	Type* returnType = nullptr;
+	std::vector<Type*> argTypes;
 	bool isVaArgs;
 
 public:
 	FunctionType(
-		std::shared_ptr<Type> returnType, 
-		std::vector<std::shared_ptr<Type>> argTypes, 
+		Type* returnType, 
+		std::vector<Type*> argTypes, 
 		bool isVaArgs, 
 		bool isConst = false
 	);
 
 	// -1 = not change, 0 = set to false, 1 = set to true
-	virtual std::shared_ptr<Type> copy(i32 makeConst = -1) const override;
+	virtual Type* copy(i32 makeConst = -1) const override;
 
-	i32 equalsOrLessConstantThan(const std::shared_ptr<Type>& other) const override; // < 0 if not equal, < -4096 if not equal at all
+	i32 equalsOrLessConstantThan(Type* other) const override; // < 0 if not equal, < -4096 if not equal at all
 
 	llvm::FunctionType* to_llvmFunctionType() const;
 	llvm::Type* to_llvm() const override;
@@ -191,9 +203,9 @@ public:
 	u64 getBitSize() const override;
 
 public:
-	static std::shared_ptr<FunctionType> createType(
-		std::shared_ptr<Type> returnType,
-		std::vector<std::shared_ptr<Type>> argTypes,
+	static FunctionType* createType(
+		Type* returnType,
+		std::vector<Type*> argTypes,
 		bool isVaArgs,
 		bool isConst = false
 	);
@@ -210,9 +222,9 @@ public:
 	);
 
 	// -1 = not change, 0 = set to false, 1 = set to true
-	virtual std::shared_ptr<Type> copy(i32 makeConst = -1) const override;
+	virtual Type* copy(i32 makeConst = -1) const override;
 
-	i32 equalsOrLessConstantThan(const std::shared_ptr<Type>& other) const override; // < 0 if not equal, < -4096 if not equal at all
+	i32 equalsOrLessConstantThan(Type* other) const override; // < 0 if not equal, < -4096 if not equal at all
 
 	llvm::Type* to_llvm() const override;
 	std::string toString() const override;
@@ -221,7 +233,7 @@ public:
 	u64 getBitSize() const override;
 
 public:
-	static std::shared_ptr<TypeNodeType> createType(
+	static TypeNodeType* createType(
 		std::shared_ptr<TypeNode> node,
 		bool isConst = false
 	);
@@ -230,20 +242,20 @@ public:
 // Note: to be used in TypeNode, otherwise must be wrapped in TypeNodeType
 class StructType final : public Type {
 public:
-	std::vector<std::shared_ptr<Type>> fieldTypes;
+	std::vector<Type*> fieldTypes;
 
 public:
 	StructType(
-		std::vector<std::shared_ptr<Type>> fieldTypes,
+		std::vector<Type*> fieldTypes,
 		bool isConst = false
 	);
 
 	// -1 = not change, 0 = set to false, 1 = set to true
-	virtual std::shared_ptr<Type> copy(i32 makeConst = -1) const override;
+	virtual Type* copy(i32 makeConst = -1) const override;
 
-	i32 equalsOrLessConstantThan(const std::shared_ptr<Type>& other) const override; // < 0 if not equal, < -4096 if not equal at all
+	i32 equalsOrLessConstantThan(Type* other) const override; // < 0 if not equal, < -4096 if not equal at all
 
-	bool isEquivalentTo(std::vector<std::shared_ptr<Type>>& types);
+	bool isEquivalentTo(std::vector<Type*>& types);
 
 	llvm::Type* to_llvm() const override;
 	std::string toString() const override;
@@ -252,22 +264,22 @@ public:
 	u64 getBitSize() const override;
 
 public:
-	static std::shared_ptr<StructType> createType(
-		std::vector<std::shared_ptr<Type>> fieldTypes,
+	static StructType* createType(
+		std::vector<Type*> fieldTypes,
 		bool isConst = false
 	);
 };
 
 
 bool isImplicitlyConverible(
-	const std::shared_ptr<Type>& from, 
-	const std::shared_ptr<Type>& to, 
+	Type* from, 
+	Type* to, 
 	bool isFromCompileTime = false
 );
 
 bool isExplicitlyConverible(
-	const std::shared_ptr<Type>& from, 
-	const std::shared_ptr<Type>& to
+	Type* from, 
+	Type* to
 );
 
 // Evaluates the value of convertibility to the other type
@@ -276,14 +288,14 @@ bool isExplicitlyConverible(
 // otherwise - unequal
 // Negative value - cannot be implicitly converted at all
 i32 evaluateConvertibility(
-	const std::shared_ptr<Type>& from,
-	const std::shared_ptr<Type>& to,
+	Type* from,
+	Type* to,
 	bool isFromCompileTime = false);
 
 // Returns the type both types can be converted to, returns nullptr if cannot be converted
-std::shared_ptr<Type> findCommonType(
-	const std::shared_ptr<Type>& first, 
-	const std::shared_ptr<Type>& second,
+Type* findCommonType(
+	Type* first, 
+	Type* second,
 	bool isFirstCompileTime = false, 
 	bool isSecondCompileTime = false
 );
@@ -6,7 +6,7 @@ std::vector<TypeNode> g_basicTypeNodes;
 TypeNode::TypeNode(
     std::string name, 
     TypeQualities qualities, 
-    std::shared_ptr<Type> type, 
+    Type* type, 
     llvm::Type* llvmType,
     std::vector<Variable> fields, 
     std::vector<Function> methods, 
@@ -14,7 +14,7 @@ TypeNode::TypeNode(
 ) : 
     name(std::move(name)), 
     qualities(qualities), 
-    type(std::move(type)), 
+    type(type), 
     llvmType(llvmType),
     fields(std::move(fields)), 
     methods(std::move(methods)), 
@@ -30,7 +30,7 @@ TypeNode::TypeNode(TypeNode& other)
 TypeNode::TypeNode(TypeNode&& other) :
     name(std::move(other.name)), 
     qualities(other.qualities), 
-    type(std::move(other.type)), 
+    type(other.type), 
     llvmType(other.llvmType),
     fields(std::move(other.fields)), 
     methods(std::move(other.methods)), 
@@ -41,7 +41,7 @@ TypeNode::TypeNode(TypeNode&& other) :
 TypeNode& TypeNode::operator=(TypeNode&& other) {
     name = std::move(other.name);
     qualities = other.qualities;
-    type = std::move(other.type);
+    type = other.type;
     llvmType = other.llvmType;
     fields = std::move(other.fields);
     methods = std::move(other.methods);
@@ -100,7 +100,7 @@ Function* TypeNode::getMethod(const std::string& name, Visibility visibility, bo
 
 Function* TypeNode::getMethod(
     const std::string& name,
-    const std::vector<std::shared_ptr<Type>>& argTypes,
+    const std::vector<Type*>& argTypes,
     const std::vector<bool>& isCompileTime,
     bool isStatic
 ) {
@@ -119,7 +119,7 @@ Function* TypeNode::getMethod(
 
 Function* TypeNode::chooseMethod(
     const std::string& name,
-    const std::vector<std::shared_ptr<Type>>& argTypes,
+    const std::vector<Type*>& argTypes,
     const std::vector<bool>& isCompileTime,
     Visibility visibility,
     bool isStatic
@@ -171,7 +171,7 @@ std::shared_ptr<TypeNode> TypeNode::getType(const std::string& name, Visibility
     return nullptr;
 }
 
-std::shared_ptr<Type> TypeNode::genType(std::shared_ptr<TypeNode> typeNode, bool isConst) {
+Type* TypeNode::genType(std::shared_ptr<TypeNode> typeNode, bool isConst) {
     if (typeNode->type && typeNode->type->basicType == BasicType::TYPE_NODE) {
         return typeNode->type;
     } else {
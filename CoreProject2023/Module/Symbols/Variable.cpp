@@ -2,12 +2,12 @@
 
 Variable::Variable(
 	std::string name, 
-	std::shared_ptr<Type> type, 
+	Type* type, 
 	VariableQualities qualities, 
 	std::shared_ptr<LLVMVariableManager> value
 ) : 
 	name(std::move(name)), 
-	type(std::move(type)), 
+	type(type), 
 	qualities(qualities),
 	valueManager(value) {
 	if (!valueManager) {
@@ -16,10 +16,23 @@ Variable::Variable(
 }
 
 Variable::Variable(Variable& other)
-	: Variable(other.name, other.type, other.qualities, other.valueManager) {
+	: name(other.name), type(other.type), qualities(other.qualities), valueManager(other.valueManager), localValue(other.localValue) {
 
 }
 
+Variable Variable::createLocal(std::string name, Type* type, VariableQualities qualities, llvm::Value* value) {
+	Variable result;
+	result.name = std::move(name);
+	result.type = type;
+	result.qualities = qualities;
+	result.localValue = value;
+	return result;
+}
+
 llvm::Value* Variable::getValue() {
+	if (!valueManager) {
+		return localValue;
+	}
+
 	return valueManager->getVariableValueForCurrentModule(this);
 }
@@ -6,13 +6,14 @@
 
 struct Variable {
 	std::string name;
-	std::shared_ptr<Type> type;
+	Type* type = nullptr;
 	VariableQualities qualities;
-	std::shared_ptr<LLVMVariableManager> valueManager = std::make_shared<LLVMVariableManager>();
+	std::shared_ptr<LLVMVariableManager> valueManager; // nullptr for a local variable
+	llvm::Value* localValue = nullptr; // the value of a local variable
 
 	Variable(
 		std::string name, 
-		std::shared_ptr<Type> type, 
+		Type* type, 
 		VariableQualities qualities, 
 		std::shared_ptr<LLVMVariableManager> value
 	);
@@ -20,5 +21,11 @@ struct Variable {
 	Variable(Variable&&) = default;
 	Variable(Variable& other);
 
+	// A local variable is used only within its function, so it keeps its value without a manager
+	static Variable createLocal(std::string name, Type* type, VariableQualities qualities, llvm::Value* value);
+
 	llvm::Value* getValue();
+
+private:
+	Variable() = default;
 };
\ No newline at end of file
@@ -0,0 +1,19 @@
+#include "ASTArena.h"
+#include <Utils/Statistics.h>
+
+STATISTIC(NumASTBytes, "ast", "bytes allocated for nodes in the arena");
+
+ASTArena* g_astArena = nullptr;
+
+void* ASTArena::allocate(size_t size, size_t alignment) {
+	NumASTBytes += size;
+	return m_allocator.Allocate(size, llvm::Align(alignment));
+}
+
+bool ASTArena::contains(const void* ptr) {
+	return m_allocator.identifyObject(ptr).hasValue();
+}
+
+void ASTArena::reset() {
+	m_allocator.Reset();
+}
@@ -0,0 +1,27 @@
+#pragma once
+#include <llvm/Support/Allocator.h>
+#include <Utils/Defs.h>
+
+/*
+	The memory of the AST nodes of the module being compiled.
+	The nodes are allocated by bumping a pointer in big slabs instead of a heap allocation per node,
+	so the nodes of a function lie close to each other, and the memory is freed at once after the module's code generation.
+	The nodes are still owned by std::unique_ptr and rewritten by Visitor as before,
+	only the deallocation of the arena's memory does nothing.
+	The nodes created while no arena is active are allocated on the heap.
+*/
+
+class ASTArena final {
+private:
+	// Big slabs keep the search of the slab of a node (on its deallocation) short
+	llvm::BumpPtrAllocatorImpl<llvm::MallocAllocator, 1024 * 1024> m_allocator;
+
+public:
+	void* allocate(size_t size, size_t alignment);
+	bool contains(const void* ptr);
+
+	// Frees all the nodes, they must be destroyed already; the first slab is kept for the next module
+	void reset();
+};
+
+extern ASTArena* g_astArena; // the active arena, nullptr if none
@@ -27,7 +27,7 @@ void FunctionDeclaration::generate() {
 		g_function = m_function;
 		size_t index = 0;
 		for (size_t i = 0; i < m_function->prototype.args().size(); i++) {
-			Argument& arg = m_function->prototype.args()[i];
+			const Argument& arg = m_function->prototype.args()[i];
 			VariableQualities qualities;
 			if (arg.type->isConst) {
 				qualities.setVariableType(VariableType::CONST);
@@ -63,6 +63,7 @@ void FunctionDeclaration::generate() {
 		g_module->deleteBlock();
 		llvm::verifyFunction(*fun);
 		g_functionPassManager->run(*fun, *g_functionAnalysisManager);
+		g_functionAnalysisManager->clear(*fun, fun->getName()); // the function is finished, its analyses are not needed anymore
 	}
 
 	g_safety.pop();
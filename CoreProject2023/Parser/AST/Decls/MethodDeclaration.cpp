@@ -29,7 +29,7 @@ void MethodDeclaration::generate() {
 		g_function = m_method;
 		size_t index = 0;
 		for (size_t i = 0; i < m_method->prototype.args().size(); i++) {
-			Argument& arg = m_method->prototype.args()[i];
+			const Argument& arg = m_method->prototype.args()[i];
 			VariableQualities qualities;
 			if (arg.type->isConst) {
 				qualities.setVariableType(VariableType::CONST);
@@ -61,6 +61,7 @@ void MethodDeclaration::generate() {
 		g_module->deleteBlock();
 		llvm::verifyFunction(*fun);
 		g_functionPassManager->run(*fun, *g_functionAnalysisManager);
+		g_functionAnalysisManager->clear(*fun, fun->getName()); // the function is finished, its analyses are not needed anymore
 	}
 
 	g_safety.pop();
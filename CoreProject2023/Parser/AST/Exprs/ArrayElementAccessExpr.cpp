@@ -23,7 +23,7 @@ ArrayElementAccessExpr::ArrayElementAccessExpr(std::unique_ptr<Expression> array
 		}
 	}
 
-	const std::shared_ptr<Type>& arrayType = Type::dereference(m_arrayExpr->getType());
+	Type* arrayType = Type::dereference(m_arrayExpr->getType());
 	if (!isString(arrayType->basicType) && arrayType->basicType != BasicType::ARRAY
 		&& arrayType->basicType != BasicType::DYN_ARRAY && arrayType->basicType != BasicType::POINTER) {
 		ErrorManager::parserError(
@@ -59,7 +59,7 @@ ArrayElementAccessExpr::ArrayElementAccessExpr(std::unique_ptr<Expression> array
 	}
 
 	if (m_arrayExpr->isLVal()) {
-		m_type = PointerType::createType(BasicType::LVAL_REFERENCE, std::move(m_type), m_arrayExpr->getType()->isConst);
+		m_type = PointerType::createType(BasicType::LVAL_REFERENCE, m_type, m_arrayExpr->getType()->isConst);
 	}
 }
 
@@ -74,14 +74,14 @@ llvm::Value* ArrayElementAccessExpr::generate() {
 		args.push_back(std::move(m_indexExpr));
 		return FunctionCallExpr::makeFunctionCall(
 			m_operatorFunc->getValue(),
-			m_operatorFunc->prototype.genType().get(),
+			m_operatorFunc->prototype.genType(),
 			args,
 			m_errLine
 		);
 	}
 
 	llvm::Value* arrayVal = m_arrayExpr->generate();
-	const std::shared_ptr<Type>& arrayType = Type::dereference(m_arrayExpr->getType());
+	Type* arrayType = Type::dereference(m_arrayExpr->getType());
 	arrayVal = llvm_utils::convertValueTo(arrayType, m_arrayExpr->getType(), arrayVal);
 
 	if (isString(arrayType->basicType) || arrayType->basicType == BasicType::DYN_ARRAY) {
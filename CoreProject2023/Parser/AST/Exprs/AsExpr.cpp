@@ -3,9 +3,9 @@
 #include <Module/LLVMGlobals.h>
 #include <Module/LLVMUtils.h>
 
-AsExpr::AsExpr(std::unique_ptr<Expression> arg, std::shared_ptr<Type> type)
+AsExpr::AsExpr(std::unique_ptr<Expression> arg, Type* type)
 	: m_arg(std::move(arg)) {
-	m_type = std::move(type);
+	m_type = type;
 	m_safety = Safety::UNSAFE;
 	g_safety.tryUse(m_safety, m_errLine);
 }
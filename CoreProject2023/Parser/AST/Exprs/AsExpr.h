@@ -6,7 +6,7 @@ class AsExpr final : public Expression {
 	FRIEND_CLASS_VISITORS
 
 public:
-	AsExpr(std::unique_ptr<Expression> arg, std::shared_ptr<Type> type);
+	AsExpr(std::unique_ptr<Expression> arg, Type* type);
 
 	void accept(Visitor* visitor, std::unique_ptr<Expression>& node) override;
 	llvm::Value* generate() override;
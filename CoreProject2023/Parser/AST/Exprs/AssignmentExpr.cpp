@@ -43,7 +43,7 @@ AssignmentExpr::AssignmentExpr(
 	
 	// Looking for operator-function if there is such
 	if (Type::dereference(m_lval->getType())->basicType >= BasicType::STR8) {
-		std::vector<std::shared_ptr<Type>> argTypes = { m_lval->getType(), m_expr->getType() };
+		std::vector<Type*> argTypes = { m_lval->getType(), m_expr->getType() };
 		if (Function* operFunc = g_module->chooseOperator(
 			assignmentOpToString(m_op),
 			argTypes,
@@ -72,7 +72,7 @@ llvm::Value* AssignmentExpr::generate() {
 		args.push_back(std::move(m_expr));
 		return FunctionCallExpr::makeFunctionCall(
 			m_operatorFunc->getValue(),
-			m_operatorFunc->prototype.genType().get(),
+			m_operatorFunc->prototype.genType(),
 			args,
 			m_errLine
 		);
@@ -51,8 +51,8 @@ BinaryExpr::BinaryExpr(
 	m_right(std::move(right)), 
 	m_op(op) 
 {
-	auto& rightType = m_right->getType();
-	auto& leftType = m_left->getType();
+	Type* rightType = m_right->getType();
+	Type* leftType = m_left->getType();
 	bool isRightIntegerLike = isInteger(Type::dereference(rightType)->basicType)
 		|| Type::dereference(rightType)->basicType == BasicType::BOOL;
 
@@ -64,7 +64,7 @@ BinaryExpr::BinaryExpr(
 			|| Type::dereference(leftType)->basicType >= BasicType::STR8
 			|| m_op == BinaryOp::POWER
 			|| (m_op == BinaryOp::MOD && (!isRightIntegerLike || !isLeftIntegerLike)))) {
-		std::vector<std::shared_ptr<Type>> argTypes = { leftType, rightType };
+		std::vector<Type*> argTypes = { leftType, rightType };
 		if (Function* operFunc = g_module->chooseOperator(
 			binaryOpToString(m_op),
 			argTypes,
@@ -117,8 +117,7 @@ BinaryExpr::BinaryExpr(
 			leftType->toString() + " and " + rightType->toString()
 		);
 	} else if (!isLVal() && isReference(m_type->basicType)) {
-		std::shared_ptr<Type> tmp = m_type->asPointerType()->elementType;
-		m_type = std::move(tmp);
+		m_type = m_type->asPointerType()->elementType;
 	}
 }
 
@@ -133,7 +132,7 @@ llvm::Value* BinaryExpr::generate() {
 		args.push_back(std::move(m_right));
 		return FunctionCallExpr::makeFunctionCall(
 			m_operatorFunc->getValue(),
-			m_operatorFunc->prototype.genType().get(),
+			m_operatorFunc->prototype.genType(),
 			args,
 			m_errLine
 		);
@@ -149,7 +148,7 @@ std::string BinaryExpr::toString() const {
 llvm::Value* BinaryExpr::generateBinaryOperation(
 	std::unique_ptr<Expression>& left,
 	std::unique_ptr<Expression>& right,
-	std::shared_ptr<Type>& resultingType,
+	Type* resultingType,
 	BinaryOp op,
 	bool convertToResultingType
 ) {
@@ -179,12 +178,12 @@ llvm::Value* BinaryExpr::generateBinaryOperation(
 				leftVal = llvm_utils::convertValueTo(resultingType, left->getType(), leftVal);
 				rightVal = llvm_utils::convertValueTo(resultingType, right->getType(), rightVal);
 			} else {
-				std::shared_ptr<Type> uint64T = Type::createType(BasicType::U64);
+				Type* uint64T = Type::createType(BasicType::U64);
 				leftVal = llvm_utils::convertValueTo(uint64T, left->getType(), leftVal);
 				rightVal = llvm_utils::convertValueTo(uint64T, right->getType(), rightVal);
 			}
 		} else {
-			std::shared_ptr<Type> commonType = findCommonType(
+			Type* commonType = findCommonType(
 				right->getType(),
 				left->getType(),
 				right->isCompileTime(),
@@ -196,7 +195,7 @@ llvm::Value* BinaryExpr::generateBinaryOperation(
 		}
 	} else {
 		if (op < BinaryOp::LOGICAL_AND && resultingType->basicType == BasicType::POINTER) { // must be executed anyway
-			std::shared_ptr<Type> uint64T = Type::createType(BasicType::U64);
+			Type* uint64T = Type::createType(BasicType::U64);
 			leftVal = llvm_utils::convertValueTo(uint64T, left->getType(), leftVal);
 			rightVal = llvm_utils::convertValueTo(uint64T, right->getType(), rightVal);
 		} else {
@@ -258,7 +257,7 @@ llvm::Value* BinaryExpr::generateBinaryOperation(
 			break;
 		}
 
-		std::shared_ptr<Type> uint64T = Type::createType(BasicType::U64);
+		Type* uint64T = Type::createType(BasicType::U64);
 		return llvm_utils::convertValueTo(resultingType, uint64T, rightVal);
 	}
 
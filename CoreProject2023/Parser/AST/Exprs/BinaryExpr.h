@@ -47,7 +47,7 @@ public:
 	static llvm::Value* generateBinaryOperation(
 		std::unique_ptr<Expression>& left,
 		std::unique_ptr<Expression>& right,
-		std::shared_ptr<Type>& resultingType,
+		Type* resultingType,
 		BinaryOp op,
 		bool convertToResultingType
 	);
@@ -30,7 +30,7 @@ ConditionalExpr::ConditionalExpr(std::vector<std::unique_ptr<Expression>> exprs,
 
 		if (Type::dereference(left->getType())->basicType >= BasicType::STR8
 			|| Type::dereference(right->getType())->basicType >= BasicType::STR8) {
-			std::vector<std::shared_ptr<Type>> argTypes = { left->getType(), right->getType() };
+			std::vector<Type*> argTypes = { left->getType(), right->getType() };
 			if (Function* operFunc = g_module->chooseOperator(
 				conditionOpToString(m_ops[i]),
 				argTypes,
@@ -69,7 +69,7 @@ llvm::Value* ConditionalExpr::generate() {
 
 		if (m_operatorFuncs[i] != nullptr) {
 			std::vector<llvm::Value*> args;
-			std::vector<std::shared_ptr<Type>> argTypes;
+			std::vector<Type*> argTypes;
 			std::vector<bool> isCompileTime;
 
 			args.push_back(orig_left);
@@ -81,7 +81,7 @@ llvm::Value* ConditionalExpr::generate() {
 			isCompileTime.push_back(m_exprs[i + 1]->isCompileTime());
 			values[i] = FunctionCallExpr::makeFunctionCall(
 				m_operatorFuncs[i]->getValue(),
-				m_operatorFuncs[i]->prototype.genType().get(),
+				m_operatorFuncs[i]->prototype.genType(),
 				args,
 				argTypes,
 				isCompileTime,
@@ -92,7 +92,7 @@ llvm::Value* ConditionalExpr::generate() {
 		}
 
 		// Default operators
-		std::shared_ptr<Type> commonType = findCommonType(
+		Type* commonType = findCommonType(
 			m_exprs[i]->getType(),
 			m_exprs[i + 1]->getType(),
 			m_exprs[i]->isCompileTime(),
@@ -1,6 +1,6 @@
 #include "Expression.h"
 
-const std::shared_ptr<Type>& Expression::getType() const {
+Type* Expression::getType() const {
     return m_type;
 }
 
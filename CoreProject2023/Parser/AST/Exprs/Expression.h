@@ -8,13 +8,13 @@ namespace llvm {
 
 class Expression : public INode {
 protected:
-	std::shared_ptr<Type> m_type;
+	Type* m_type = nullptr;
 
 public:
 	virtual void accept(Visitor* visitor, std::unique_ptr<Expression>& node) = 0;
 	virtual llvm::Value* generate() = 0;
 
-	const std::shared_ptr<Type>& getType() const;
+	Type* getType() const;
 	virtual bool isCompileTime() const;
 	bool isLVal() const;
 };
\ No newline at end of file
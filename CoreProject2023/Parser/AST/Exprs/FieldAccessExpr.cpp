@@ -9,7 +9,7 @@ FieldAccessExpr::FieldAccessExpr(std::unique_ptr<Expression> expr, std::string m
 	: m_expr(std::move(expr)), m_memberName(std::move(memberName)) {
 
 	// Getting the resulting type
-	const std::shared_ptr<Type>& type = Type::dereference(m_expr->getType());
+	Type* type = Type::dereference(m_expr->getType());
 	if (isString(type->basicType)) {
 		if (m_memberName == "data") {
 			BasicType basicType = BasicType((u8)type->basicType - (u8)BasicType::STR8 + (u8)BasicType::C8);
@@ -36,7 +36,7 @@ FieldAccessExpr::FieldAccessExpr(std::unique_ptr<Expression> expr, std::string m
 			}
 		}
 	} else if (type->basicType == BasicType::TYPE_NODE) {
-		TypeNode* typeNode = ((TypeNodeType*)type.get())->node.get();
+		TypeNode* typeNode = ((TypeNodeType*)type)->node.get();
 		for (auto& var : typeNode->fields) {
 			if (var.name == m_memberName) {
 				m_type = var.type->copy(type->isConst);
@@ -47,7 +47,7 @@ FieldAccessExpr::FieldAccessExpr(std::unique_ptr<Expression> expr, std::string m
 	if (m_type) {
 		if (m_expr->isLVal()) {
 			bool isConst = m_expr->getType()->isConst;
-			m_type = PointerType::createType(BasicType::LVAL_REFERENCE, std::move(m_type));
+			m_type = PointerType::createType(BasicType::LVAL_REFERENCE, m_type);
 		}
 
 		return;
@@ -65,10 +65,10 @@ void FieldAccessExpr::accept(Visitor* visitor, std::unique_ptr<Expression>& node
 }
 
 llvm::Value* FieldAccessExpr::generate() {
-	const std::shared_ptr<Type>& type = Type::dereference(m_expr->getType());
+	Type* type = Type::dereference(m_expr->getType());
 	if (type->basicType == BasicType::ARRAY) {
 		if (m_memberName == "size") { // compile time
-			return llvm_utils::getConstantInt(((ArrayType*)type.get())->size, 64);
+			return llvm_utils::getConstantInt(((ArrayType*)type)->size, 64);
 		}
 	}
 
@@ -94,13 +94,13 @@ llvm::Value* FieldAccessExpr::generate() {
 			}
 		} else if (type->basicType == BasicType::TUPLE) {
 			if (std::all_of(m_memberName.begin(), m_memberName.end(), isdigit)) {
-				TupleType* tupType = (TupleType*)type.get();
+				TupleType* tupType = (TupleType*)type;
 				if (size_t i = std::stoull(m_memberName); i < tupType->subTypes.size()) {
 					return g_builder->CreateGEP(type->to_llvm(), value, { zeroInt, llvm_utils::getConstantInt(i, 32) });
 				}
 			}
 		} else if (type->basicType == BasicType::TYPE_NODE) {
-			TypeNode* typeNode = ((TypeNodeType*)type.get())->node.get();
+			TypeNode* typeNode = ((TypeNodeType*)type)->node.get();
 			for (size_t i = 0; i < typeNode->fields.size(); i++) {
 				if (typeNode->fields[i].name == m_memberName) {
 					return g_builder->CreateGEP(type->to_llvm(), value, { zeroInt, llvm_utils::getConstantInt(i, 32) });
@@ -122,13 +122,13 @@ llvm::Value* FieldAccessExpr::generate() {
 			}
 		} else if (type->basicType == BasicType::TUPLE) {
 			if (std::all_of(m_memberName.begin(), m_memberName.end(), isdigit)) {
-				TupleType* tupType = (TupleType*)type.get();
+				TupleType* tupType = (TupleType*)type;
 				if (size_t i = std::stoull(m_memberName); i < tupType->subTypes.size()) {
 					return g_builder->CreateExtractValue(value, llvm::ArrayRef<u32>(i));
 				}
 			}
 		} else if (type->basicType == BasicType::TYPE_NODE) {
-			TypeNode* typeNode = ((TypeNodeType*)type.get())->node.get();
+			TypeNode* typeNode = ((TypeNodeType*)type)->node.get();
 			for (size_t i = 0; i < typeNode->fields.size(); i++) {
 				if (typeNode->fields[i].name == m_memberName) {
 					return g_builder->CreateExtractValue(value, llvm::ArrayRef<u32>(i));
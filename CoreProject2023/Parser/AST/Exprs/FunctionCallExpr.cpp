@@ -97,7 +97,7 @@ llvm::Value* FunctionCallExpr::makeFunctionCall(
 	llvm::Function* functionValue,
 	FunctionType* functionType,
 	std::vector<llvm::Value*>& args,
-	const std::vector<std::shared_ptr<Type>>& argTypes,
+	const std::vector<Type*>& argTypes,
 	const std::vector<bool>& isCompileTime,
 	u64 errLine
 ) {
@@ -22,11 +22,11 @@ void MethodCallExpr::accept(Visitor* visitor, std::unique_ptr<Expression>& node)
 }
 
 llvm::Value* MethodCallExpr::generate() {
-	std::shared_ptr<FunctionType> funcType = m_func->prototype.genType();
+	FunctionType* funcType = m_func->prototype.genType();
 
 	return FunctionCallExpr::makeFunctionCall(
 		m_func->getValue(),
-		funcType.get(),
+		funcType,
 		m_argExprs,
 		m_errLine
 	);
@@ -43,7 +43,7 @@ bool UnaryExpr::isUnaryOpDefinable(UnaryOp op) {
 UnaryExpr::UnaryExpr(std::unique_ptr<Expression> expr, UnaryOp op)
 	: m_expr(std::move(expr)), m_op(op) {
 	if (isUnaryOpDefinable(m_op) && Type::dereference(m_expr->getType())->basicType >= BasicType::STR8) {
-		std::vector<std::shared_ptr<Type>> argTypes;
+		std::vector<Type*> argTypes;
 		argTypes.push_back(m_expr->getType());
 		if (Function* operFunc = g_module->chooseOperator(
 			unaryOpToString(m_op),
@@ -152,7 +152,7 @@ llvm::Value* UnaryExpr::generate() {
 		args.push_back(std::move(m_expr));
 		return FunctionCallExpr::makeFunctionCall(
 			m_operatorFunc->getValue(),
-			m_operatorFunc->prototype.genType().get(),
+			m_operatorFunc->prototype.genType(),
 			args,
 			m_errLine
 		);
@@ -169,8 +169,8 @@ llvm::Value* UnaryExpr::generate() {
 		return m_expr->generate();
 	} else if (m_op == UnaryOp::MOVE) {
 		llvm::Value* value = m_expr->generate();
-		const std::shared_ptr<Type>& type = isPointer(m_expr->getType()->basicType) ?
-			((PointerType*)m_expr->getType().get())->elementType
+		Type* type = isPointer(m_expr->getType()->basicType) ?
+			((PointerType*)m_expr->getType())->elementType
 			: m_expr->getType();
 
 		llvm::Value* result = g_builder->CreateLoad(type->to_llvm(), value);
@@ -250,7 +250,7 @@ llvm::Value* UnaryExpr::createIncOrDecrement(
 	bool isPostfix,
 	bool isRVal
 ) {
-	const std::shared_ptr<Type>& type = isPostfix ? m_type : m_type->asPointerType()->elementType;
+	Type* type = isPostfix ? m_type : m_type->asPointerType()->elementType;
 
 	llvm::Value* ptr_value = m_expr->generate();
 	llvm::Value* value = g_builder->CreateLoad(type->to_llvm(), ptr_value);
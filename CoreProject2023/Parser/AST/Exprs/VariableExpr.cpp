@@ -15,7 +15,6 @@ VariableExpr::VariableExpr(std::shared_ptr<TypeNode> typeNode, Variable* variabl
 
 VariableExpr::~VariableExpr() {
 	m_name.~basic_string();
-	m_type.~shared_ptr();
 	if (m_isStaticTypeMember) {
 		m_typeNode.~shared_ptr();
 	} else {
@@ -1,6 +1,10 @@
 #include "INode.h"
 #include <vector>
 #include <Lexer/Token.h>
+#include <Utils/Statistics.h>
+#include "ASTArena.h"
+
+STATISTIC(NumNodes, "ast", "nodes created");
 
 extern u64* g_pos;
 extern std::vector<Token>* g_toks;
@@ -8,6 +12,8 @@ extern std::vector<Token>* g_toks;
 std::string INode::s_tabs = "";
 
 INode::INode() {
+	++NumNodes;
+
 	if (*g_pos >= g_toks->size()) {
 		m_errLine = -1;
 	} else {
@@ -19,6 +25,21 @@ INode::INode() {
 	}
 }
 
+void* INode::operator new(size_t size) {
+	if (g_astArena) {
+		return g_astArena->allocate(size, alignof(std::max_align_t));
+	}
+
+	return ::operator new(size);
+}
+
+void INode::operator delete(void* ptr) {
+	// The memory of the arena is freed at once
+	if (!g_astArena || !g_astArena->contains(ptr)) {
+		::operator delete(ptr);
+	}
+}
+
 u64 INode::getErrLine() const {
 	return m_errLine;
 }
@@ -12,6 +12,10 @@ class INode {
 public:
 	INode();
 
+	// The nodes are allocated in the active ASTArena
+	static void* operator new(size_t size);
+	static void operator delete(void* ptr);
+
 	virtual std::string toString() const = 0;
 
 	u64 getErrLine() const;
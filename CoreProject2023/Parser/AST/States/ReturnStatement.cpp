@@ -15,7 +15,7 @@ void ReturnStatement::accept(Visitor* visitor, std::unique_ptr<Statement>& node)
 }
 
 void ReturnStatement::generate() {
-	std::shared_ptr<Type> returnType;
+	Type* returnType = nullptr;
 	if (g_function->prototype.getQualities().getFunctionKind() == FunctionKind::CONSTRUCTOR) {
 		returnType = Type::createType(BasicType::NO_TYPE);
 	} else {
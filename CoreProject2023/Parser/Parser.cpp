@@ -67,7 +67,7 @@ void Parser::useDeclaration() {
 }
 
 std::unique_ptr<Declaration> Parser::structDeclaration() {
-	std::string name = consume(TokenType::WORD).data;
+	std::string name = consume(TokenType::WORD).data();
 	std::shared_ptr<TypeNode> typeNode = g_module->getType(m_pos - 2);
 	g_safety.push(typeNode->qualities.getSafety());
 
@@ -109,7 +109,7 @@ std::unique_ptr<Declaration> Parser::methodDeclaration(std::shared_ptr<TypeNode>
 	match(TokenType::NATIVE);
 
 	std::string alias;
-	std::shared_ptr<Type> returnType;
+	Type* returnType = nullptr;
 	FunctionKind funcKind = FunctionKind::COMMON;
 	if (match(TokenType::TYPE)) {
 		funcKind = FunctionKind::CONSTRUCTOR;
@@ -120,10 +120,10 @@ std::unique_ptr<Declaration> Parser::methodDeclaration(std::shared_ptr<TypeNode>
 		alias = "this";
 		returnType = TypeNode::genType(parentType);
 	} else if (match(TokenType::WORD)) {
-		alias = peek(-1).data;
+		alias = peek(-1).data();
 	} else { // operator-functions
 		funcKind = FunctionKind::OPERATOR;
-		alias = m_toks[m_pos].data;
+		alias = m_toks[m_pos].data();
 		if (m_toks[m_pos].type == TokenType::LPAR || m_toks[m_pos].type == TokenType::LBRACKET) {
 			m_pos++;
 		}
@@ -136,7 +136,7 @@ std::unique_ptr<Declaration> Parser::methodDeclaration(std::shared_ptr<TypeNode>
 	consume(TokenType::LPAR);
 	size_t i = 0;
 
-	std::vector<std::shared_ptr<Type>> argTypes;
+	std::vector<Type*> argTypes;
 
 	if (!isStatic) {
 		argTypes.push_back(PointerType::createType(BasicType::XVAL_REFERENCE, TypeNode::genType(parentType))); // this
@@ -148,15 +148,15 @@ std::unique_ptr<Declaration> Parser::methodDeclaration(std::shared_ptr<TypeNode>
 				VariableQualities qualities;
 				qualities.setVisibility(Visibility::LOCAL);
 				
-				std::shared_ptr<Type> argType = TypeParser(m_toks, m_pos).consumeType();
+				Type* argType = TypeParser(m_toks, m_pos).consumeType();
 
 				if (argType->isConst) {
 					qualities.setVariableType(VariableType::CONST);
 				}
 
-				std::string name = consume(TokenType::WORD).data;
+				std::string name = consume(TokenType::WORD).data();
 				argTypes.push_back(argType);
-				g_module->addLocalVariable(name, std::move(argType), qualities, nullptr);
+				g_module->addLocalVariable(name, argType, qualities, nullptr);
 			}
 
 			i++;
@@ -225,7 +225,7 @@ std::unique_ptr<Declaration> Parser::fieldDeclaration(std::shared_ptr<TypeNode>
 
 	TypeParser(m_toks, m_pos).skipConsumeType();
 
-	std::string alias = consume(TokenType::WORD).data;
+	std::string alias = consume(TokenType::WORD).data();
 	Visibility visibility = (g_type && g_type->isEquals(parentType))
 		? Visibility::PRIVATE : Visibility::PUBLIC;
 
@@ -264,7 +264,7 @@ std::unique_ptr<Declaration> Parser::functionDeclaration() {
 	if (!match(TokenType::RPAR)) {
 		do {
 			if (!match(TokenType::ETCETERA))  {
-				Argument& argument = function->prototype.args()[i];
+				const Argument& argument = function->prototype.args()[i];
 				VariableQualities qualities;
 				qualities.setVisibility(Visibility::LOCAL);
 
@@ -274,7 +274,7 @@ std::unique_ptr<Declaration> Parser::functionDeclaration() {
 					qualities.setVariableType(VariableType::CONST);
 				}
 
-				std::string name = consume(TokenType::WORD).data;
+				std::string name = consume(TokenType::WORD).data();
 				g_module->addLocalVariable(argument.name, argument.type, qualities, nullptr);
 			}
 
@@ -333,7 +333,7 @@ std::unique_ptr<Declaration> Parser::variableDeclaration() {
 	match(TokenType::EXTERN);
 	TypeParser(m_toks, m_pos).skipConsumeType();
 
-	std::string alias = consume(TokenType::WORD).data;
+	std::string alias = consume(TokenType::WORD).data();
 
 	std::unique_ptr<Expression> expr = nullptr;
 	if (match(TokenType::EQ)) {
@@ -407,13 +407,13 @@ std::unique_ptr<Statement> Parser::statement() {
 }
 
 std::unique_ptr<Statement> Parser::variableDefStatement(bool toConsumeSemicolon) {
-	std::shared_ptr<Type> type;
+	Type* type = nullptr;
 	bool isStatic = match(TokenType::STATIC);
 	if (!match(TokenType::VAR)) {
 		type = TypeParser(m_toks, m_pos).consumeType();
 	}
 
-	std::string alias = consume(TokenType::WORD).data;
+	std::string alias = consume(TokenType::WORD).data();
 
 	std::unique_ptr<Expression> expr = nullptr;
 	if (match(TokenType::EQ)) {
@@ -436,7 +436,7 @@ std::unique_ptr<Statement> Parser::variableDefStatement(bool toConsumeSemicolon)
 	qualities.setVariableType(type->isConst ? VariableType::CONST : VariableType::COMMON);
 	qualities.setVisibility(isStatic ? Visibility::PRIVATE : Visibility::LOCAL);
 	g_module->addLocalVariable(alias, type, qualities, nullptr);
-	Variable variable(alias, std::move(type), qualities, nullptr);
+	Variable variable(alias, type, qualities, nullptr);
 
 	if (toConsumeSemicolon) {
 		consume(TokenType::SEMICOLON);
@@ -787,11 +787,11 @@ std::unique_ptr<Expression> Parser::postfix() {
 			continue;
 		} if (match(TokenType::DOT)) { // member access
 			m_pos++;
-			std::string memberName = peek(-1).data; // it can be WORD or any number
-			const std::shared_ptr<Type>& thisType = Type::dereference(expr->getType());
+			std::string memberName = peek(-1).data(); // it can be WORD or any number
+			Type* thisType = Type::dereference(expr->getType());
 
 			if (thisType->basicType == BasicType::TYPE_NODE) { // can be method
-				std::shared_ptr<TypeNode> typeNode = ((TypeNodeType*)thisType.get())->node;
+				std::shared_ptr<TypeNode> typeNode = ((TypeNodeType*)thisType)->node;
 				Visibility visibility = (g_type && g_type->isEquals(typeNode)) 
 					? Visibility::PRIVATE : Visibility::PUBLIC;
 
@@ -824,41 +824,41 @@ std::unique_ptr<Expression> Parser::primary() {
 
 	// Literals
 	if (match(TokenType::NUMBERI8)) {
-		return std::make_unique<ValueExpr>(Value(BasicType::I8, _ValueUnion((i64)std::stol(peek(-1).data))));
+		return std::make_unique<ValueExpr>(Value(BasicType::I8, _ValueUnion((i64)std::stol(peek(-1).data()))));
 	} if (match(TokenType::NUMBERI16)) {
-		return std::make_unique<ValueExpr>(Value(BasicType::I16, _ValueUnion((i64)std::stol(peek(-1).data))));
+		return std::make_unique<ValueExpr>(Value(BasicType::I16, _ValueUnion((i64)std::stol(peek(-1).data()))));
 	} if (match(TokenType::NUMBERI32)) {
-		return std::make_unique<ValueExpr>(Value(BasicType::I32, _ValueUnion((i64)std::stol(peek(-1).data))));
+		return std::make_unique<ValueExpr>(Value(BasicType::I32, _ValueUnion((i64)std::stol(peek(-1).data()))));
 	} if (match(TokenType::NUMBERI64)) {
-		return std::make_unique<ValueExpr>(Value(BasicType::I64, _ValueUnion((i64)std::stol(peek(-1).data))));
+		return std::make_unique<ValueExpr>(Value(BasicType::I64, _ValueUnion((i64)std::stol(peek(-1).data()))));
 	} if (match(TokenType::NUMBERU8)) {
-		return std::make_unique<ValueExpr>(Value(BasicType::U8, _ValueUnion((u64)std::stoull(peek(-1).data))));
+		return std::make_unique<ValueExpr>(Value(BasicType::U8, _ValueUnion((u64)std::stoull(peek(-1).data()))));
 	} if (match(TokenType::NUMBERU16)) {
-		return std::make_unique<ValueExpr>(Value(BasicType::U16, _ValueUnion((u64)std::stoull(peek(-1).data))));
+		return std::make_unique<ValueExpr>(Value(BasicType::U16, _ValueUnion((u64)std::stoull(peek(-1).data()))));
 	} if (match(TokenType::NUMBERU32)) {
-		return std::make_unique<ValueExpr>(Value(BasicType::U32, _ValueUnion((u64)std::stoull(peek(-1).data))));
+		return std::make_unique<ValueExpr>(Value(BasicType::U32, _ValueUnion((u64)std::stoull(peek(-1).data()))));
 	} if (match(TokenType::NUMBERU64)) {
-		return std::make_unique<ValueExpr>(Value(BasicType::U64, _ValueUnion((u64)std::stoull(peek(-1).data))));
+		return std::make_unique<ValueExpr>(Value(BasicType::U64, _ValueUnion((u64)std::stoull(peek(-1).data()))));
 	} if (match(TokenType::NUMBERF32)) {
-		return std::make_unique<ValueExpr>(Value(BasicType::F32, _ValueUnion((f64)std::stod(peek(-1).data))));
+		return std::make_unique<ValueExpr>(Value(BasicType::F32, _ValueUnion((f64)std::stod(peek(-1).data()))));
 	} if (match(TokenType::NUMBERF64)) {
-		return std::make_unique<ValueExpr>(Value(BasicType::F64, _ValueUnion((f64)std::stod(peek(-1).data))));
+		return std::make_unique<ValueExpr>(Value(BasicType::F64, _ValueUnion((f64)std::stod(peek(-1).data()))));
 	} if (match(TokenType::FALSE)) {
 		return std::make_unique<ValueExpr>(Value(BasicType::BOOL, _ValueUnion((u64)0)));
 	} if (match(TokenType::TRUE)) {
 		return std::make_unique<ValueExpr>(Value(BasicType::BOOL, _ValueUnion((u64)1)));
 	} if (match(TokenType::LETTER8)) {
-		return std::make_unique<ValueExpr>(Value(BasicType::C8, _ValueUnion((i64)peek(-1).data[0])));
+		return std::make_unique<ValueExpr>(Value(BasicType::C8, _ValueUnion((i64)peek(-1).data()[0])));
 	} if (match(TokenType::LETTER16)) {
-		return std::make_unique<ValueExpr>(Value(BasicType::C16, _ValueUnion((i64)*(i16*)&peek(-1).data[0])));
+		return std::make_unique<ValueExpr>(Value(BasicType::C16, _ValueUnion((i64)*(i16*)&peek(-1).data()[0])));
 	} if (match(TokenType::LETTER32)) {
-		return std::make_unique<ValueExpr>(Value(BasicType::C32, _ValueUnion((i64)*(i32*)&peek(-1).data[0])));
+		return std::make_unique<ValueExpr>(Value(BasicType::C32, _ValueUnion((i64)*(i32*)&peek(-1).data()[0])));
 	} if (match(TokenType::TEXT8)) {
-		return std::make_unique<ValueExpr>(Value(BasicType::STR8, _ValueUnion(peek(-1).data)));
+		return std::make_unique<ValueExpr>(Value(BasicType::STR8, _ValueUnion(peek(-1).data())));
 	} if (match(TokenType::TEXT16)) {
-		return std::make_unique<ValueExpr>(Value(BasicType::STR16, _ValueUnion(peek(-1).data)));
+		return std::make_unique<ValueExpr>(Value(BasicType::STR16, _ValueUnion(peek(-1).data())));
 	} if (match(TokenType::TEXT32)) {
-		return std::make_unique<ValueExpr>(Value(BasicType::STR32, _ValueUnion(peek(-1).data)));
+		return std::make_unique<ValueExpr>(Value(BasicType::STR32, _ValueUnion(peek(-1).data())));
 	} if (match(TokenType::NULLPTR)) {
 		return std::make_unique<ValueExpr>(Value(BasicType::POINTER, _ValueUnion()));
 	}
@@ -885,21 +885,21 @@ std::unique_ptr<Expression> Parser::primary() {
 				} while (match(TokenType::COMMA));
 				consume(TokenType::RPAR);
 			}
-			return std::make_unique<TypeConversionExpr>(std::move(args), std::move(type));
+			return std::make_unique<TypeConversionExpr>(std::move(args), type);
 		} else if (match(TokenType::LBRACE)) { // array expression (like u8 {...})
 			if (type->basicType == BasicType::ARRAY) {
 				return parseArrayValue(type->asArrayType()->elementType, type->asArrayType()->size);
 			} else {
-				return parseArrayValue(std::move(type), 0);
+				return parseArrayValue(type, 0);
 			}
 		} else if (match(TokenType::DOT)) { // static members
-			if (std::shared_ptr<Type>& containingType = Type::dereference(type);
+			if (Type* containingType = Type::dereference(type);
 				containingType->basicType == BasicType::TYPE_NODE) {
-				std::shared_ptr<TypeNode> typeNode = ((TypeNodeType*)containingType.get())->node;
+				std::shared_ptr<TypeNode> typeNode = ((TypeNodeType*)containingType)->node;
 				Visibility visibility = (g_type && g_type->isEquals(typeNode))
 					? Visibility::PRIVATE : Visibility::PUBLIC;
 
-				std::string name = consume(TokenType::WORD).data;
+				std::string name = consume(TokenType::WORD).data();
 				SymbolType symType = typeNode->getSymbolType(name, visibility, true);
 
 				// Variable
@@ -935,7 +935,7 @@ std::unique_ptr<Expression> Parser::primary() {
 	
 	// Identifier
 	if (match(TokenType::WORD)) {
-		std::string name = peek(-1).data;
+		std::string name = peek(-1).data();
 		std::string moduleName = "";
 		SymbolType symType = g_module->getSymbolType(name);
 
@@ -943,7 +943,7 @@ std::unique_ptr<Expression> Parser::primary() {
 		if (symType == SymbolType::MODULE) {
 			consume(TokenType::DOT);
 			moduleName = std::move(name);
-			name = consume(TokenType::WORD).data;
+			name = consume(TokenType::WORD).data();
 			symType = g_module->getSymbolType(moduleName, name);
 		}
 
@@ -971,7 +971,7 @@ std::unique_ptr<Expression> Parser::primary() {
 	return nullptr;
 }
 
-std::unique_ptr<Expression> Parser::parseArrayValue(std::shared_ptr<Type> type, u64 size) {
+std::unique_ptr<Expression> Parser::parseArrayValue(Type* type, u64 size) {
 	std::vector<std::unique_ptr<Expression>> values;
 	while (!match(TokenType::RBRACE)) {
 		values.push_back(expression());
@@ -983,7 +983,7 @@ std::unique_ptr<Expression> Parser::parseArrayValue(std::shared_ptr<Type> type,
 		}
 	}
 
-	return std::make_unique<ArrayExpr>(std::move(type), size, std::move(values));
+	return std::make_unique<ArrayExpr>(type, size, std::move(values));
 }
 
 std::unique_ptr<Expression> Parser::parseMethodCall(
@@ -993,7 +993,7 @@ std::unique_ptr<Expression> Parser::parseMethodCall(
 	bool isStatic
 ) {
 	if (match(TokenType::LESS)) { // template
-		std::vector<std::shared_ptr<Type>> argTypes;
+		std::vector<Type*> argTypes;
 		argTypes.push_back(TypeNodeType::createType(typeNode));
 
 		if (!match(TokenType::GREATER)) {
@@ -1012,7 +1012,7 @@ std::unique_ptr<Expression> Parser::parseMethodCall(
 		}
 	} else if (match(TokenType::LPAR)) { // function call
 		std::vector<std::unique_ptr<Expression>> args;
-		std::vector<std::shared_ptr<Type>> argTypes;
+		std::vector<Type*> argTypes;
 		std::vector<bool> isCompileTime;
 
 		if (!isStatic) {
@@ -1061,7 +1061,7 @@ std::unique_ptr<Expression> Parser::parseMethodCall(
 
 std::unique_ptr<Expression> Parser::parseFunctionValue(std::string moduleName, std::string name) {
 	if (match(TokenType::LESS)) { // template
-		std::vector<std::shared_ptr<Type>> argTypes;
+		std::vector<Type*> argTypes;
 		if (!match(TokenType::GREATER)) {
 			do {
 				argTypes.push_back(TypeParser(m_toks, m_pos).consumeType());
@@ -1078,7 +1078,7 @@ std::unique_ptr<Expression> Parser::parseFunctionValue(std::string moduleName, s
 		}
 	} else if (match(TokenType::LPAR)) { // function call
 		std::vector<std::unique_ptr<Expression>> args;
-		std::vector<std::shared_ptr<Type>> argTypes;
+		std::vector<Type*> argTypes;
 		std::vector<bool> isCompileTime;
 
 		while (!match(TokenType::RPAR)) {
@@ -1112,7 +1112,7 @@ std::unique_ptr<Expression> Parser::parseFunctionValue(std::string moduleName, s
 void Parser::functionCallError(
 	std::string moduleName, 
 	std::string name, 
-	const std::vector<std::shared_ptr<Type>>& argTypes, 
+	const std::vector<Type*>& argTypes, 
 	bool isMultipleFunctionsFound
 ) {
 	std::string error = "function: ";
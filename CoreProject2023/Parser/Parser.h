@@ -43,7 +43,7 @@ private:
 	std::unique_ptr<Expression> postfix();
 	std::unique_ptr<Expression> primary();
 
-	std::unique_ptr<Expression> parseArrayValue(std::shared_ptr<Type> type, u64 size);
+	std::unique_ptr<Expression> parseArrayValue(Type* type, u64 size);
 
 	std::unique_ptr<Expression> parseMethodCall(
 		std::shared_ptr<TypeNode> typeNode, 
@@ -58,7 +58,7 @@ private:
 	void functionCallError(
 		std::string moduleName,
 		std::string name,
-		const std::vector<std::shared_ptr<Type>>& argTypes,
+		const std::vector<Type*>& argTypes,
 		bool isMultipleFunctionsFound // true if searched exact functions, false if tried to chooseS
 	);
 
@@ -105,11 +105,11 @@ bool TypeParser::skipType() {
 						getCurrLine(),
 						"expected a number"
 					);
-				} else if (peek(-1).data[0] == '-' || peek(-1).data == "0") {
+				} else if (peek(-1).data()[0] == '-' || peek(-1).data() == "0") {
 					ErrorManager::typeError(
 						ErrorID::E3052_NEGATIVE_SIZE_ARRAY,
 						getCurrLine(),
-						"array size: " + peek(-1).data
+						"array size: " + peek(-1).data()
 					);
 				} else {
 					consume(TokenType::RBRACKET);
@@ -136,9 +136,9 @@ bool TypeParser::skipType() {
 	return true;
 }
 
-std::shared_ptr<Type> TypeParser::consumeType() {
+Type* TypeParser::consumeType() {
 	if (auto type = parseType()) {
-		return std::move(type);
+		return type;
 	}
 
 	ErrorManager::typeError(
@@ -150,28 +150,28 @@ std::shared_ptr<Type> TypeParser::consumeType() {
 	return nullptr;
 }
 
-std::shared_ptr<Type> TypeParser::parseTypeOrGetNoType() {
+Type* TypeParser::parseTypeOrGetNoType() {
 	savePos();
 	if (auto type = parseType()) {
-		return std::move(type);
+		return type;
 	}
 
 	loadPos();
 	return Type::createType(BasicType::NO_TYPE);
 }
 
-std::shared_ptr<Type> TypeParser::tryParseType() {
+Type* TypeParser::tryParseType() {
 	savePos();
 	if (auto type = parseType()) {
-		return std::move(type);
+		return type;
 	}
 
 	loadPos();
 	return nullptr;
 }
 
-std::shared_ptr<Type> TypeParser::parseType() {
-	std::shared_ptr<Type> result;
+Type* TypeParser::parseType() {
+	Type* result = nullptr;
 
 	// First part: type itself
 	bool isConst = match(TokenType::CONST);
@@ -197,8 +197,8 @@ std::shared_ptr<Type> TypeParser::parseType() {
 		case TokenType::F64: result = Type::createType(BasicType::F64, isConst); break;
 
 		case TokenType::FUNC: {
-			std::shared_ptr<Type> returnType = parseTypeOrGetNoType();
-			std::vector<std::shared_ptr<Type>> argTypes;
+			Type* returnType = parseTypeOrGetNoType();
+			std::vector<Type*> argTypes;
 			bool isVaArgs = false;
 
 			consume(TokenType::LPAR);
@@ -221,10 +221,10 @@ std::shared_ptr<Type> TypeParser::parseType() {
 				consume(TokenType::RPAR);
 			}
 
-			result = FunctionType::createType(std::move(returnType), std::move(argTypes), isVaArgs, isConst);
+			result = FunctionType::createType(returnType, std::move(argTypes), isVaArgs, isConst);
 		}; break;
 		case TokenType::TUPLE: {
-			std::vector<std::shared_ptr<Type>> subTypes;
+			std::vector<Type*> subTypes;
 			consume(TokenType::LESS);
 			if (!match(TokenType::GREATER)) {
 				do {
@@ -236,7 +236,7 @@ std::shared_ptr<Type> TypeParser::parseType() {
 			result = TupleType::createType(std::move(subTypes), isConst);
 		}; break;
 		case TokenType::STRUCT: {
-			std::vector<std::shared_ptr<Type>> fieldTypes;
+			std::vector<Type*> fieldTypes;
 			consume(TokenType::LBRACE);
 			while (!match(TokenType::RBRACE)) {
 				fieldTypes.push_back(consumeType());
@@ -247,13 +247,13 @@ std::shared_ptr<Type> TypeParser::parseType() {
 		}; break;
 
 		case TokenType::WORD: {
-			std::string name = peek(-1).data;
+			std::string name = peek(-1).data();
 			std::string moduleName = "";
 			SymbolType symType = g_module->getSymbolType(name);
 			if (symType == SymbolType::MODULE) {
 				consume(TokenType::DOT);
 				moduleName = std::move(name);
-				name = consume(TokenType::WORD).data;
+				name = consume(TokenType::WORD).data();
 				symType = g_module->getSymbolType(moduleName, name);
 			}
 
@@ -270,18 +270,18 @@ std::shared_ptr<Type> TypeParser::parseType() {
 		}; break;
 		case TokenType::TYPEOF: {
 			bool hasParens = match(TokenType::LPAR);
-			std::string name = consume(TokenType::WORD).data;
+			std::string name = consume(TokenType::WORD).data();
 			std::string moduleName = "";
 			SymbolType symType = g_module->getSymbolType(name);
 			if (symType == SymbolType::MODULE) {
 				consume(TokenType::DOT);
 				moduleName = std::move(name);
-				name = consume(TokenType::WORD).data;
+				name = consume(TokenType::WORD).data();
 				symType = g_module->getSymbolType(moduleName, name);
 			}
 
 			if (symType == SymbolType::VARIABLE) {
-				result = std::shared_ptr<Type>(g_module->getVariable(moduleName, name)->type);
+				result = g_module->getVariable(moduleName, name)->type;
 			} else if (symType == SymbolType::FUNCTION) {
 				result = g_module->getFunction(moduleName, name)->prototype.genType();
 			}
@@ -298,7 +298,7 @@ std::shared_ptr<Type> TypeParser::parseType() {
 		bool isConst = match(TokenType::CONST);
 		if (match(TokenType::LBRACKET)) {
 			if (match(TokenType::RBRACKET)) { // dynamic array
-				result = PointerType::createType(BasicType::DYN_ARRAY, std::move(result), isConst);
+				result = PointerType::createType(BasicType::DYN_ARRAY, result, isConst);
 				continue;
 			} else { // static array
 				if (!matchRange(TokenType::NUMBERI8, TokenType::NUMBERU64)) {
@@ -307,21 +307,21 @@ std::shared_ptr<Type> TypeParser::parseType() {
 						getCurrLine(),
 						"expected a number"
 					);
-				} else if (peek(-1).data[0] == '-' || peek(-1).data == "0") {
+				} else if (peek(-1).data()[0] == '-' || peek(-1).data() == "0") {
 					ErrorManager::typeError(
 						ErrorID::E3052_NEGATIVE_SIZE_ARRAY,
 						getCurrLine(),
-						"array size: " + peek(-1).data
+						"array size: " + peek(-1).data()
 					);
 				} else {
-					u64 size = std::stoull(peek(-1).data);
+					u64 size = std::stoull(peek(-1).data());
 					consume(TokenType::RBRACKET);
-					result = ArrayType::createType(std::move(result), size, isConst);
+					result = ArrayType::createType(result, size, isConst);
 					continue;
 				}
 			}
 		} else if (match(TokenType::QUESTION)) { // optional
-			result = PointerType::createType(BasicType::OPTIONAL, std::move(result), isConst);
+			result = PointerType::createType(BasicType::OPTIONAL, result, isConst);
 			continue;
 		} else if (match(TokenType::ANDAND)) { // rvalue reference
 			if (isReference(result->basicType)) {
@@ -334,7 +334,7 @@ std::shared_ptr<Type> TypeParser::parseType() {
 				break;
 			}
 
-			result = PointerType::createType(BasicType::RVAL_REFERENCE, std::move(result), false);
+			result = PointerType::createType(BasicType::RVAL_REFERENCE, result, false);
 			continue;
 		}
 
@@ -349,7 +349,7 @@ std::shared_ptr<Type> TypeParser::parseType() {
 				break;
 			}
 
-			result = PointerType::createType(BasicType::POINTER, std::move(result), isConst);
+			result = PointerType::createType(BasicType::POINTER, result, isConst);
 			continue;
 		} else if (match(TokenType::POWER)) { // pointer to pointer
 			if (isReference(result->basicType)) {
@@ -362,8 +362,8 @@ std::shared_ptr<Type> TypeParser::parseType() {
 				break;
 			}
 
-			result = PointerType::createType(BasicType::POINTER, std::move(result), isConst);
-			result = PointerType::createType(BasicType::POINTER, std::move(result), false);
+			result = PointerType::createType(BasicType::POINTER, result, isConst);
+			result = PointerType::createType(BasicType::POINTER, result, false);
 			continue;
 		} else if (match(TokenType::AND)) { // reference
 			if (isReference(result->basicType)) {
@@ -376,7 +376,7 @@ std::shared_ptr<Type> TypeParser::parseType() {
 				break;
 			}
 
-			result = PointerType::createType(BasicType::LVAL_REFERENCE, std::move(result), isConst);
+			result = PointerType::createType(BasicType::LVAL_REFERENCE, result, isConst);
 			continue;
 		}
 
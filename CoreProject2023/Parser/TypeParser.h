@@ -14,16 +14,16 @@ public:
 	bool skipType();
 
 	// Requires a type, otherwise prints error
-	std::shared_ptr<Type> consumeType();
+	Type* consumeType();
 
 	// Returns NO_TYPE if there is no type expression, returns m_pos to m_originalPos
-	std::shared_ptr<Type> parseTypeOrGetNoType();
+	Type* parseTypeOrGetNoType();
 
 	// Returns NO_TYPE if there is no type expression, returns m_pos to m_originalPos
-	std::shared_ptr<Type> tryParseType();
+	Type* tryParseType();
 
 	// Returns nullptr if there is no type expression
-	std::shared_ptr<Type> parseType();
+	Type* parseType();
 
 	// isFalseOnDot - whether the -type-. is counted as not a type here
 	bool isType(bool isFalseOnDot = false);
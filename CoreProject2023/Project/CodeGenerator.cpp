@@ -0,0 +1,76 @@
+#include "CodeGenerator.h"
+#include <iostream>
+#include <Utils/TimeTrace.h>
+#include <llvm/IR/Module.h>
+#include <llvm/IR/LegacyPassManager.h>
+#include <llvm/ADT/Triple.h>
+#include <llvm/MC/TargetRegistry.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/raw_ostream.h>
+#include <llvm/Target/TargetOptions.h>
+#include <llvm/Target/TargetMachine.h>
+
+CodeGenerator::CodeGenerator(std::string targetTriple, std::string cpu, std::string features)
+	: m_targetTriple(std::move(targetTriple)), m_cpu(std::move(cpu)), m_features(std::move(features)) {
+
+}
+
+CodeGenerator::~CodeGenerator() = default;
+
+llvm::TargetMachine* CodeGenerator::getTargetMachine() {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	std::unique_ptr<llvm::TargetMachine>& targetMachine = m_targetMachines[std::this_thread::get_id()];
+	if (!targetMachine) {
+		targetMachine = createTargetMachine();
+	}
+
+	return targetMachine.get();
+}
+
+std::unique_ptr<llvm::TargetMachine> CodeGenerator::createTargetMachine() {
+	llvm::TargetOptions options;
+	options.UseInitArray = llvm::Triple(m_targetTriple).isOSBinFormatELF(); // .ctors are only run by the start files of GCC, which lld does not link
+	llvm::Optional<llvm::Reloc::Model> RM = llvm::Optional<llvm::Reloc::Model>();
+
+	std::string error;
+	const llvm::Target* target = llvm::TargetRegistry::lookupTarget(m_targetTriple, error);
+	if (!target) {
+		std::cout << "cannot find the target " << m_targetTriple << ": " << error << std::endl;
+		return nullptr;
+	}
+
+	return std::unique_ptr<llvm::TargetMachine>(target->createTargetMachine(m_targetTriple, m_cpu, m_features, options, RM));
+}
+
+bool CodeGenerator::emitObjectFile(llvm::Module& llvmModule, const std::string& path) {
+	TimePhase phase("Codegen", llvmModule.getModuleIdentifier());
+	llvm::TargetMachine* targetMachine = getTargetMachine();
+	if (!targetMachine) {
+		return false;
+	}
+
+	std::error_code errorCode;
+	llvm::raw_fd_ostream file(path, errorCode, llvm::sys::fs::OF_None);
+	if (errorCode) {
+		std::cout << "cannot open file " << path << ": " << errorCode.message() << std::endl;
+		return false;
+	}
+
+	llvmModule.setDataLayout(targetMachine->createDataLayout());
+	llvm::legacy::PassManager pass; // the codegen passes are bound to the output stream, so they cannot be reused
+	if (targetMachine->addPassesToEmitFile(pass, file, nullptr, llvm::CGFT_ObjectFile)) {
+		std::cout << "targetMachine can't emit a file of this type" << std::endl;
+		return false;
+	}
+
+	pass.run(llvmModule);
+	file.close();
+
+	if (file.has_error()) {
+		std::cout << "cannot write file " << path << ": " << file.error().message() << std::endl;
+		file.clear_error(); // otherwise the stream aborts on destruction
+		return false;
+	}
+
+	return true;
+}
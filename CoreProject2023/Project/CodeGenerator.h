@@ -0,0 +1,41 @@
+#pragma once
+#include <map>
+#include <mutex>
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace llvm {
+	class TargetMachine;
+	class Module;
+}
+
+/*
+	Generates the object code of llvm modules.
+	llvm::TargetMachine is not thread-safe, so each thread gets its own one, which is created once and reused for all the modules.
+	The target machines live as long as the generator, so a thread pool uses a generator of its own, destroyed along with the pool.
+*/
+
+class CodeGenerator final {
+private:
+	std::string m_targetTriple;
+	std::string m_cpu;
+	std::string m_features;
+
+	std::mutex m_mutex;
+	std::map<std::thread::id, std::unique_ptr<llvm::TargetMachine>> m_targetMachines;
+
+public:
+	CodeGenerator(std::string targetTriple, std::string cpu, std::string features);
+	~CodeGenerator();
+
+	// The target machine of the calling thread, nullptr if the target is not supported
+	llvm::TargetMachine* getTargetMachine();
+
+	// A new target machine, for the threads the compiler does not own (e.g. the ones of llvm::splitCodeGen)
+	// Returns nullptr if the target is not supported
+	std::unique_ptr<llvm::TargetMachine> createTargetMachine();
+
+	// Returns false (having printed the error) if the object file was not written
+	bool emitObjectFile(llvm::Module& llvmModule, const std::string& path);
+};
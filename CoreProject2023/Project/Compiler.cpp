@@ -1,23 +1,48 @@
 #include "Compiler.h"
+#include "Linker.h"
+#include "CodeGenerator.h"
 #include <iostream>
 #include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <atomic>
 #include <Utils/File.h>
+#include <Utils/ErrorManager.h>
 #include <Utils/String.h>
+#include <Utils/SourceBuffer.h>
+#include <Utils/TimeTrace.h>
+#include <Utils/Statistics.h>
 #include <Lexer/ModulePeeker.h>
 #include <Lexer/ImportsHandler.h>
 #include <Lexer/Lexer.h>
 #include <SymbolLoader/SymbolPreloader.h>
 #include <SymbolLoader/SymbolLoader.h>
 #include <Parser/Parser.h>
+#include <Parser/AST/ASTArena.h>
 #include <Module/LLVMGlobals.h>
+#include <Module/ModuleInterface.h>
 #include <llvm/IR/BasicBlock.h>
 #include <llvm/IR/Function.h>
 #include <llvm/IR/Type.h>
 #include <llvm/IR/DerivedTypes.h>
 #include <llvm/IR/LegacyPassManager.h>
+#include <llvm/Bitcode/BitcodeReader.h>
+#include <llvm/Bitcode/BitcodeWriter.h>
+#include <llvm/Analysis/ModuleSummaryAnalysis.h>
+#include <llvm/Analysis/ProfileSummaryInfo.h>
+#include <llvm/LTO/LTO.h>
+#include <llvm/Support/Caching.h>
+#include <llvm/CodeGen/ParallelCG.h>
+#include <llvm/ExecutionEngine/Orc/LLJIT.h>
+#include <llvm/ExecutionEngine/Orc/ExecutionUtils.h>
 #include "llvm/MC/TargetRegistry.h"
 #include <llvm/Support/TargetSelect.h>
 #include <llvm/Support/FileSystem.h>
+#include <llvm/Support/ThreadPool.h>
+#include <llvm/Support/xxhash.h>
+#include <llvm/MC/SubtargetFeature.h>
+#include <llvm/ADT/Triple.h>
 #include <llvm\Support\Host.h>
 #include <llvm\Target\TargetOptions.h>
 #include <llvm\Target\TargetMachine.h>
@@ -29,26 +54,54 @@ Compiler::Compiler(Project& project)
 	initAll();
 }
 
+Compiler::~Compiler() = default;
+
 void Compiler::buildProject() {
 	for (auto& path : m_project.getSettings().compiledCoreModules) {
 		preloadSymbols(path);
 	}
 
+	// The code of the modules loaded from interfaces is already compiled
+	std::set<std::string> interfaceObjectFiles; // several interfaces share the object file of a library built with full LTO
+	for (auto& module : g_moduleList.getModules()) {
+		if (module.getInterface() && interfaceObjectFiles.insert(module.getInterface()->getObjectFile()).second) {
+			m_filesToLink.push_back(module.getInterface()->getObjectFile());
+		}
+	}
+
+	if (m_project.getSettings().incremental && isBuildUpToDate()) {
+		return;
+	}
+
 	compileModules();
 	compileLLVM();
+
+	if (m_project.getSettings().emitInterfaces && m_project.getSettings().compilationMode == CompilationMode::Library) {
+		for (auto& module : g_moduleList.getModules()) {
+			if (!module.getInterface()) {
+				ModuleInterface::write(module, getObjectFilePath(module));
+			}
+		}
+	}
 }
 
 void Compiler::linkProject() {
-	for (auto& path : m_project.getSettings().additionalLinkedObjectFiles) {
-		m_filesToLink += ' ';
-		m_filesToLink += path;
+	if (m_project.getSettings().compilationMode == CompilationMode::Library) {
+		return; // a library has no executable
 	}
 
-	std::string linkCommand = "clang++.exe -o "
-		+ m_project.getSettings().output.getOutputFile(CompilerOutput::ExecutableData)
-		+ m_filesToLink;
+	std::vector<std::string> files = m_filesToLink;
+	files.insert(
+		files.end(),
+		m_project.getSettings().additionalLinkedObjectFiles.begin(),
+		m_project.getSettings().additionalLinkedObjectFiles.end()
+	);
 
-	system(linkCommand.c_str());
+	TimePhase phase("Link");
+	Linker linker(getTargetTriple(), m_project.getSettings().output.getOutputFile(CompilerOutput::ExecutableData), std::move(files));
+	if (!linker.link(m_project.getSettings().linker, m_project.getSettings().pgoMode == PGOMode::Instrument)) {
+		std::cout << "failed to link the project" << std::endl;
+	}
 }
 
 void Compiler::runProject() {
@@ -56,6 +109,156 @@ void Compiler::runProject() {
 	system(m_project.getSettings().output.getOutputFile(CompilerOutput::ExecutableData).c_str());
 }
 
+i32 Compiler::runProjectJIT() {
+	ASSERT(m_project.getSettings().compilationMode == CompilationMode::Program, "cannot run a library");
+	for (auto& path : m_project.getSettings().compiledCoreModules) {
+		preloadSymbols(path);
+	}
+
+	compileModules();
+
+	std::string targetTriple = getTargetTriple();
+	llvm::TargetMachine* targetMachine = m_codeGenerator->getTargetMachine();
+	ModuleRef mainModule = g_moduleList.getModule(m_project.getSettings().compiledCoreModules[0]);
+	llvm::Module& llvmModule = mainModule->getLLVMModule();
+	llvmModule.setTargetTriple(targetTriple);
+	llvmModule.setDataLayout(targetMachine->createDataLayout());
+
+	if (m_project.getSettings().output.getOutputMode(CompilerOutput::IRBeforeOpt) != CompilerOutput::NoOut) {
+		printIR(&llvmModule, false);
+	}
+
+	// The JIT owns the context of its modules, so the module is moved to a context of its own through bitcode
+	llvm::SmallVector<char, 0> bitcode;
+	llvm::raw_svector_ostream stream(bitcode);
+	llvm::WriteBitcodeToFile(llvmModule, stream);
+
+	auto context = std::make_unique<llvm::LLVMContext>();
+	llvm::MemoryBufferRef buffer(llvm::StringRef(bitcode.data(), bitcode.size()), mainModule->getPath());
+	llvm::Expected<std::unique_ptr<llvm::Module>> jitModule = llvm::parseBitcodeFile(buffer, *context);
+	if (!jitModule) {
+		std::cout << "cannot load the module for JIT: " << llvm::toString(jitModule.takeError()) << std::endl;
+		return -1;
+	}
+
+	llvm::orc::JITTargetMachineBuilder machineBuilder((llvm::Triple(targetTriple)));
+	machineBuilder.setCPU(getTargetCPU());
+	machineBuilder.addFeatures(llvm::SubtargetFeatures(getTargetFeatures()).getFeatures());
+	machineBuilder.setCodeGenOptLevel(
+		m_project.getSettings().optLevel == OptimizationLevel::O0 ? llvm::CodeGenOpt::None : llvm::CodeGenOpt::Default
+	);
+
+	llvm::Expected<std::unique_ptr<llvm::orc::LLLazyJIT>> jit = llvm::orc::LLLazyJITBuilder()
+		.setJITTargetMachineBuilder(std::move(machineBuilder))
+		.create();
+	if (!jit) {
+		std::cout << "cannot create the JIT: " << llvm::toString(jit.takeError()) << std::endl;
+		return -1;
+	}
+
+	llvm::orc::JITDylib& mainDylib = (*jit)->getMainJITDylib();
+
+	// Native functions are looked up in the compiler's process, which has the C runtime
+	auto processSymbols = llvm::orc::DynamicLibrarySearchGenerator::GetForCurrentProcess(
+		(*jit)->getDataLayout().getGlobalPrefix()
+	);
+	if (!processSymbols) {
+		std::cout << "cannot load the process' symbols: " << llvm::toString(processSymbols.takeError()) << std::endl;
+		return -1;
+	}
+
+	mainDylib.addGenerator(std::move(*processSymbols));
+
+	// The functions are optimized when they are compiled, so the startup does not depend on the size of the program
+	if (m_project.getSettings().optLevel != OptimizationLevel::O0) {
+		(*jit)->getIRTransformLayer().setTransform(
+			[this, targetMachine](llvm::orc::ThreadSafeModule module, llvm::orc::MaterializationResponsibility&) {
+				module.withModuleDo([&](llvm::Module& llvmModule) {
+					optimizeLLVMModule(&llvmModule, targetMachine, OptimizationPipeline::Functions);
+				});
+
+				return llvm::Expected<llvm::orc::ThreadSafeModule>(std::move(module));
+			}
+		);
+	}
+
+	// The code that is already compiled: the modules loaded from interfaces and the additional linked files
+	std::set<std::string> objectFiles(
+		m_project.getSettings().additionalLinkedObjectFiles.begin(),
+		m_project.getSettings().additionalLinkedObjectFiles.end()
+	);
+
+	for (auto& module : g_moduleList.getModules()) {
+		if (module.getInterface()) {
+			objectFiles.insert(module.getInterface()->getObjectFile());
+		}
+	}
+
+	auto addObjectFile = [&jit, &mainDylib](const std::string& path) -> llvm::Error {
+		std::string extension = std::filesystem::path(path).extension().string();
+		if (extension == ".a" || extension == ".lib") {
+			auto library = llvm::orc::StaticLibraryDefinitionGenerator::Load((*jit)->getObjLinkingLayer(), path.c_str());
+			if (!library) {
+				return library.takeError();
+			}
+
+			mainDylib.addGenerator(std::move(*library));
+			return llvm::Error::success();
+		}
+
+		llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> object = llvm::MemoryBuffer::getFile(path);
+		if (!object) {
+			return llvm::errorCodeToError(object.getError());
+		}
+
+		return (*jit)->addObjectFile(std::move(*object));
+	};
+
+	for (auto& path : objectFiles) {
+		if (llvm::Error error = addObjectFile(path)) {
+			std::cout << "cannot load " << path << " for JIT: " << llvm::toString(std::move(error)) << std::endl;
+			return -1;
+		}
+	}
+
+	if (llvm::Error error = (*jit)->addLazyIRModule(llvm::orc::ThreadSafeModule(std::move(*jitModule), std::move(context)))) {
+		std::cout << "cannot add the module to JIT: " << llvm::toString(std::move(error)) << std::endl;
+		return -1;
+	}
+
+	// Runs the static constructors
+	if (llvm::Error error = (*jit)->initialize(mainDylib)) {
+		std::cout << "cannot initialize the program: " << llvm::toString(std::move(error)) << std::endl;
+		return -1;
+	}
+
+	auto mainSymbol = (*jit)->getExecutionSession().lookup({ &mainDylib }, (*jit)->mangleAndIntern("main"));
+	if (!mainSymbol) {
+		std::cout << "cannot find main: " << llvm::toString(mainSymbol.takeError()) << std::endl;
+		return -1;
+	}
+
+	auto mainFunction = (i32(*)())mainSymbol->getAddress();
+	i32 exitCode = mainFunction();
+
+	// Runs the static destructors
+	if (llvm::Error error = (*jit)->deinitialize(mainDylib)) {
+		std::cout << "cannot deinitialize the program: " << llvm::toString(std::move(error)) << std::endl;
+	}
+
+	std::fflush(nullptr); // the program's output must not be lost on quick_exit
+	return exitCode;
+}
+
+void Compiler::printStatistics() {
+	Statistic::printAll();
+
+	std::cout << "Tokens per module:" << std::endl;
+	for (auto& [path, count] : m_moduleTokenCounts) {
+		std::cout << std::right << std::setw(12) << count << ' ' << path << std::endl;
+	}
+}
+
 void Compiler::initAll() {
 	llvm::InitializeAllTargetInfos();
 	llvm::InitializeAllTargets();
@@ -63,21 +266,17 @@ void Compiler::initAll() {
 	llvm::InitializeAllAsmParsers();
 	llvm::InitializeAllAsmPrinters();
 
+	m_codeGenerator = std::make_unique<CodeGenerator>(getTargetTriple(), getTargetCPU(), getTargetFeatures());
+	if (!m_codeGenerator->getTargetMachine()) {
+		ErrorManager::projectSettingsError(ErrorID::E5003_WRONG_SETTING_VALUE, -1, "unsupported target: " + getTargetTriple());
+	}
+
 	initPasses();
 	initBasicTypeNodes();
 }
 
-void Compiler::initPasses(llvm::TargetMachine* machine) {
-	llvm::OptimizationLevel optLevel;
-	switch (m_project.getSettings().optLevel) {
-		case OptimizationLevel::O0: optLevel = llvm::OptimizationLevel::O0; break;
-		case OptimizationLevel::O1: optLevel = llvm::OptimizationLevel::O1; break;
-		case OptimizationLevel::O2: optLevel = llvm::OptimizationLevel::O2; break;
-		case OptimizationLevel::O3: optLevel = llvm::OptimizationLevel::O3; break;
-	default: optLevel = llvm::OptimizationLevel::O0; break;
-	}
-
-	llvm::PassBuilder pb(machine);
+void Compiler::initPasses() {
+	llvm::PassBuilder pb(m_codeGenerator->getTargetMachine());
 
 	pb.registerModuleAnalyses(*g_moduleAnalysisManager);
 	pb.registerCGSCCAnalyses(*g_cgsccAnalysisManager);
@@ -90,7 +289,36 @@ void Compiler::initPasses(llvm::TargetMachine* machine) {
 		*g_moduleAnalysisManager
 	);
 
-	g_modulePassManager = std::make_unique<llvm::ModulePassManager>(pb.buildPerModuleDefaultPipeline(optLevel));
+	// The early simplification of each function, so that the module pipeline gets smaller IR
+	g_functionPassManager = std::make_unique<llvm::FunctionPassManager>();
+	const std::string& functionPasses = m_project.getSettings().functionPasses;
+	if (m_project.getSettings().optLevel != OptimizationLevel::O0 && !functionPasses.empty()) {
+		if (llvm::Error error = pb.parsePassPipeline(*g_functionPassManager, functionPasses)) {
+			ErrorManager::projectSettingsError(
+				ErrorID::E5003_WRONG_SETTING_VALUE,
+				-1,
+				functionPasses + " is impossible value for function-passes: " + llvm::toString(std::move(error))
+			);
+		}
+	}
+}
+
+llvm::OptimizationLevel Compiler::getLLVMOptimizationLevel() {
+	switch (m_project.getSettings().optLevel) {
+		case OptimizationLevel::O0: return llvm::OptimizationLevel::O0;
+		case OptimizationLevel::O1: return llvm::OptimizationLevel::O1;
+		case OptimizationLevel::O2: return llvm::OptimizationLevel::O2;
+		case OptimizationLevel::O3: return llvm::OptimizationLevel::O3;
+	default: return llvm::OptimizationLevel::O0;
+	}
+}
+
+llvm::Optional<llvm::PGOOptions> Compiler::getPGOOptions() {
+	switch (m_project.getSettings().pgoMode) {
+		case PGOMode::Instrument: return llvm::PGOOptions(m_project.getSettings().pgoProfile, "", "", llvm::PGOOptions::IRInstr);
+		case PGOMode::Use: return llvm::PGOOptions(m_project.getSettings().pgoProfile, "", "", llvm::PGOOptions::IRUse);
+	default: return llvm::None;
+	}
 }
 
 void Compiler::preloadSymbols(const std::string& path) {
@@ -103,25 +331,30 @@ void Compiler::preloadSymbols(const std::string& path) {
 	g_currFilePath = path;
 	g_currFileName = Module::getModuleNameFromPath(path);
 
-	// ModulePeeker
+	// ModulePeeker (reads, tokenizes the module and its imports)
 	ModuleRef thisModule;
 
 	{
+		TimePhase phase("Peek module", path);
 		ModulePeeker peeker(path);
 		thisModule = peeker.load();
 	}
 
+	if (!thisModule->getInterface()) {
+		m_moduleTokenCounts.emplace_back(path, thisModule->getTokens().size());
+	}
+
 	g_moduleList.setCurrentModule(path);
 
+	// Symbols preloading (names)
 	{
-		// Lexer
-		std::string program = readFile(path);
-		Lexer lexer(program);
-		std::vector<Token> toks = lexer.tokenize();
-
-		// Symbols preloading (names)
-		SymbolPreloader loader(toks, path);
-		loader.loadSymbols();
+		TimePhase phase("Preload symbols", path);
+		if (thisModule->getInterface()) {
+			thisModule->getInterface()->preloadSymbols(*thisModule);
+		} else {
+			SymbolPreloader loader(thisModule->getTokens(), path);
+			loader.loadSymbols();
+		}
 	}
 
 	for (auto& imp : thisModule->getImports()) {
@@ -130,6 +363,9 @@ void Compiler::preloadSymbols(const std::string& path) {
 }
 
 void Compiler::compileModules() {
+	ASTArena astArena; // reused by all the modules
+	g_astArena = &astArena;
+
 	for (auto& module : g_moduleList.getModules()) {
 		g_currFilePath = module.getPath();
 		g_currFileName = module.getName();
@@ -137,21 +373,21 @@ void Compiler::compileModules() {
 		g_moduleList.setCurrentModule(module.getPath());
 		module.loadSymbols();
 
-		// Lexer
-		std::vector<Token> toks;
-
-		{
-			std::string program = readFile(module.getPath());
-			Lexer lexer(program);
-			toks = lexer.tokenize();
+		// Only the declarations are needed from an interface
+		if (module.getInterface()) {
+			module.getInterface()->loadSymbols(module);
+			module.loadAsLLVM();
+			continue;
+		}
 
-			if (m_project.getSettings().output.getOutputMode(CompilerOutput::Lexer) != CompilerOutput::NoOut) {
-				printTokens(toks);
-			}
+		std::vector<Token>& toks = module.getTokens();
+		if (m_project.getSettings().output.getOutputMode(CompilerOutput::Lexer) != CompilerOutput::NoOut) {
+			printTokens(toks);
 		}
 
 		// Symbols loading (types)
 		{
+			TimePhase phase("Load symbols", module.getPath());
 			SymbolLoader loader(toks, module.getPath());
 			loader.loadSymbols();
 		}
@@ -159,10 +395,14 @@ void Compiler::compileModules() {
 		// Parser
 		g_moduleList.setCurrentModule(module.getPath());
 		module.loadAsLLVM();
-		g_functionPassManager = std::make_unique<llvm::FunctionPassManager>();
 		addDefaultFunctions();
 
-		std::vector<std::unique_ptr<Declaration>> astVec = Parser(toks).parse();
+		std::vector<std::unique_ptr<Declaration>> astVec;
+		{
+			TimePhase phase("Parse", module.getPath());
+			astVec = Parser(toks).parse();
+		}
+
 		if (m_project.getSettings().output.getOutputMode(CompilerOutput::ASTBeforeOpt) != CompilerOutput::NoOut) {
 			printAst(astVec, false);
 		}
@@ -173,54 +413,283 @@ void Compiler::compileModules() {
 			printAst(astVec, true);
 		}
 
-		for (auto& decl : astVec) {
-			decl->generate();
+		{
+			TimePhase phase("Generate", module.getPath());
+			for (auto& decl : astVec) {
+				decl->generate();
+			}
 		}
+
+		module.clearTokens();
+
+		astVec.clear();
+		astArena.reset();
 	}
+
+	g_astArena = nullptr;
 }
 
 void Compiler::compileLLVM() {
 	// Common settings
 	std::string targetTriple = getTargetTriple();
-
-	llvm::TargetOptions options;
-	llvm::Optional<llvm::Reloc::Model> RM = llvm::Optional<llvm::Reloc::Model>();
-
-	std::string error;
-	const llvm::Target* target = llvm::TargetRegistry::lookupTarget(targetTriple, error);
-	if (!target) {
-		std::cout << error;
-	}
-
-	llvm::TargetMachine* targetMachine = target->createTargetMachine(targetTriple, "generic", "", options, RM);
+	llvm::TargetMachine* targetMachine = m_codeGenerator->getTargetMachine();
 
 	// Compiling llvm modules
 	if (m_project.getSettings().compilationMode == CompilationMode::Program) {
 		ModuleRef mainModule = g_moduleList.getModule(m_project.getSettings().compiledCoreModules[0]);
 
 		mainModule->getLLVMModule().setTargetTriple(targetTriple);
-		std::string buildFilePath = m_project.getSettings().output.getOutputFile(CompilerOutput::ObjectData);
+		std::vector<std::string> buildFilePaths = getProgramObjectFilePaths();
 
-		compileLLVMModule(
-			&mainModule->getLLVMModule(),
-			buildFilePath,
-			targetMachine
-		);
+		bool isCompiled = buildFilePaths.size() == 1
+			? compileLLVMModule(&mainModule->getLLVMModule(), buildFilePaths[0], targetMachine)
+			: compileLLVMModulePartitioned(&mainModule->getLLVMModule(), buildFilePaths, targetMachine);
+
+		// A missing or partial object file must not be taken for an up to date one by the next build
+		if (isCompiled && m_project.getSettings().incremental) {
+			saveObjectFileHash(buildFilePaths[0], getProgramHash());
+		}
+	} else if (m_project.getSettings().lto != LTOMode::Off) {
+		compileLLVMModulesWithLTO(targetTriple, targetMachine);
+	} else if (m_project.getSettings().jobs != 1 && g_moduleList.getModules().size() > 1) {
+		compileLLVMModulesInParallel(targetTriple);
 	} else { // Compiling as a library
 		for (auto& module : g_moduleList.getModules()) {
+			if (module.getInterface()) {
+				continue;
+			}
+
+			std::string buildFilePath = getObjectFilePath(module);
+			if (m_project.getSettings().incremental && isObjectFileUpToDate(buildFilePath, getModuleHash(module))) {
+				m_filesToLink.push_back(buildFilePath);
+				continue;
+			}
+
 			llvm::Module& llvmModule = module.getLLVMModule();
 			llvmModule.setTargetTriple(targetTriple);
 
-			compileLLVMModule(
+			bool isCompiled = compileLLVMModule(
 				&llvmModule,
-				genBuildFilePath(module.getPath(), ".o"),
+				buildFilePath,
 				targetMachine
 			);
+
+			if (isCompiled && m_project.getSettings().incremental) {
+				saveObjectFileHash(buildFilePath, getModuleHash(module));
+			}
 		}
 	} 
 }
 
-void Compiler::compileLLVMModule(
+void Compiler::compileLLVMModulesInParallel(const std::string& targetTriple) {
+	// llvm::LLVMContext is not thread-safe, so each module is moved to a context of its own through bitcode
+	struct ModuleTask {
+		std::string buildFilePath;
+		llvm::SmallVector<char, 0> bitcode;
+		u64 hash = 0;
+		bool isCompiled = false; // set by the worker once the object file is written
+	};
+
+	std::vector<ModuleTask> tasks;
+	tasks.reserve(g_moduleList.getModules().size());
+	for (auto& module : g_moduleList.getModules()) {
+		if (module.getInterface()) {
+			continue;
+		}
+
+		std::string buildFilePath = getObjectFilePath(module);
+		m_filesToLink.push_back(buildFilePath);
+
+		u64 hash = m_project.getSettings().incremental ? getModuleHash(module) : 0;
+		if (m_project.getSettings().incremental && isObjectFileUpToDate(buildFilePath, hash)) {
+			continue;
+		}
+
+		llvm::Module& llvmModule = module.getLLVMModule();
+		llvmModule.setTargetTriple(targetTriple);
+
+		if (m_project.getSettings().output.getOutputMode(CompilerOutput::IRBeforeOpt) != CompilerOutput::NoOut) {
+			printIR(&llvmModule, false);
+		}
+
+		ModuleTask& task = tasks.emplace_back();
+		task.buildFilePath = std::move(buildFilePath);
+		task.hash = hash;
+
+		llvm::raw_svector_ostream stream(task.bitcode);
+		llvm::WriteBitcodeToFile(llvmModule, stream);
+	}
+
+	// The target machines of the pool's threads are destroyed along with the pool
+	CodeGenerator codeGenerator(targetTriple, getTargetCPU(), getTargetFeatures());
+	std::mutex outputMutex;
+	llvm::ThreadPool pool(llvm::hardware_concurrency(m_project.getSettings().jobs));
+	for (auto& task : tasks) {
+		pool.async([this, &task, &codeGenerator, &outputMutex]() {
+			TimeTraceThread timeTraceThread;
+			llvm::LLVMContext context;
+			llvm::MemoryBufferRef buffer(llvm::StringRef(task.bitcode.data(), task.bitcode.size()), task.buildFilePath);
+			llvm::Expected<std::unique_ptr<llvm::Module>> llvmModule = llvm::parseBitcodeFile(buffer, context);
+			if (!llvmModule) {
+				std::lock_guard<std::mutex> lock(outputMutex);
+				std::cout << "cannot load the module for " << task.buildFilePath << ": "
+					<< llvm::toString(llvmModule.takeError()) << std::endl;
+				return;
+			}
+
+			llvm::TargetMachine* targetMachine = codeGenerator.getTargetMachine(); // the one of the pool's thread
+			if (m_project.getSettings().optLevel != OptimizationLevel::O0) {
+				optimizeLLVMModule(llvmModule->get(), targetMachine);
+
+				if (m_project.getSettings().output.getOutputMode(CompilerOutput::IRAfterOpt) != CompilerOutput::NoOut) {
+					std::lock_guard<std::mutex> lock(outputMutex);
+					printIR(llvmModule->get(), true);
+				}
+			}
+
+			task.isCompiled = codeGenerator.emitObjectFile(**llvmModule, task.buildFilePath);
+		});
+	}
+
+	pool.wait();
+
+	if (m_project.getSettings().incremental) {
+		for (auto& task : tasks) {
+			if (task.isCompiled) {
+				saveObjectFileHash(task.buildFilePath, task.hash);
+			}
+		}
+	}
+}
+
+void Compiler::compileLLVMModulesWithLTO(const std::string& targetTriple, llvm::TargetMachine* targetMachine) {
+	bool isThin = m_project.getSettings().lto == LTOMode::Thin;
+	std::mutex outputMutex;
+
+	llvm::lto::Config config;
+	config.CPU = getTargetCPU();
+	config.MAttrs = { getTargetFeatures() };
+	config.RelocModel = llvm::Optional<llvm::Reloc::Model>();
+	config.OptLevel = unsigned(m_project.getSettings().optLevel);
+	config.DefaultTriple = targetTriple;
+	config.TimeTraceEnabled = g_timeTrace.isEnabled(); // the backend threads attach to the trace themselves
+	config.TimeTraceGranularity = TimeTrace::GRANULARITY;
+
+	if (m_project.getSettings().output.getOutputMode(CompilerOutput::IRAfterOpt) != CompilerOutput::NoOut) {
+		config.PostOptModuleHook = [this, &outputMutex](unsigned task, const llvm::Module& llvmModule) -> bool {
+			std::lock_guard<std::mutex> lock(outputMutex);
+			printIR(const_cast<llvm::Module*>(&llvmModule), true);
+			return true;
+		};
+	}
+
+	llvm::lto::LTO lto(
+		std::move(config),
+		llvm::lto::createInProcessThinBackend(llvm::heavyweight_hardware_concurrency(m_project.getSettings().jobs))
+	);
+
+	// Task 0 is the merged module of the full LTO, the next ones are the modules of ThinLTO in the order they were added
+	std::vector<std::string> objectFiles = { "" };
+	std::vector<std::unique_ptr<llvm::MemoryBuffer>> bitcodes; // must outlive the LTO
+	std::set<std::string> definedSymbols;
+	std::vector<Module*> modules;
+
+	for (auto& module : g_moduleList.getModules()) {
+		if (module.getInterface()) {
+			continue;
+		}
+
+		llvm::Module& llvmModule = module.getLLVMModule();
+		llvmModule.setTargetTriple(targetTriple);
+		llvmModule.setDataLayout(targetMachine->createDataLayout()); // required by LTO
+
+		if (m_project.getSettings().output.getOutputMode(CompilerOutput::IRBeforeOpt) != CompilerOutput::NoOut) {
+			printIR(&llvmModule, false);
+		}
+
+		if (m_project.getSettings().optLevel != OptimizationLevel::O0) {
+			optimizeLLVMModule(&llvmModule, targetMachine, OptimizationPipeline::LTOPreLink);
+		}
+
+		// ThinLTO needs the summary of the module's functions to decide what to import
+		llvm::SmallVector<char, 0> bitcode;
+		llvm::raw_svector_ostream stream(bitcode);
+		if (isThin) {
+			llvm::ProfileSummaryInfo profileSummary(llvmModule);
+			llvm::ModuleSummaryIndex summary = llvm::buildModuleSummaryIndex(llvmModule, nullptr, &profileSummary);
+			llvm::WriteBitcodeToFile(llvmModule, stream, false, &summary);
+		} else {
+			llvm::WriteBitcodeToFile(llvmModule, stream);
+		}
+
+		// The module's path is its identifier in LTO, so it must be unique
+		bitcodes.push_back(llvm::MemoryBuffer::getMemBufferCopy(llvm::StringRef(bitcode.data(), bitcode.size()), module.getPath()));
+		llvm::Expected<std::unique_ptr<llvm::lto::InputFile>> input = llvm::lto::InputFile::create(bitcodes.back()->getMemBufferRef());
+		if (!input) {
+			std::cout << "cannot load the module " << module.getPath() << " for LTO: " << llvm::toString(input.takeError()) << std::endl;
+			return;
+		}
+
+		// A library is linked with unknown code, so all the symbols stay visible, the first definition of a symbol is used
+		std::vector<llvm::lto::SymbolResolution> resolutions;
+		for (auto& symbol : (*input)->symbols()) {
+			llvm::lto::SymbolResolution& resolution = resolutions.emplace_back();
+			resolution.VisibleToRegularObj = true;
+			resolution.Prevailing = !symbol.isUndefined() && definedSymbols.insert(symbol.getName().str()).second;
+		}
+
+		if (llvm::Error error = lto.add(std::move(*input), resolutions)) {
+			std::cout << "cannot add the module " << module.getPath() << " to LTO: " << llvm::toString(std::move(error)) << std::endl;
+			return;
+		}
+
+		if (isThin) {
+			objectFiles.push_back(getObjectFilePath(module));
+		} else if (objectFiles[0].empty()) {
+			objectFiles[0] = getObjectFilePath(module); // the same for all the modules
+		}
+
+		modules.push_back(&module);
+	}
+
+	TimePhase phase("LTO");
+	std::atomic<bool> areObjectsWritten = true;
+	llvm::Error error = lto.run([&objectFiles, &areObjectsWritten](unsigned task) -> std::unique_ptr<llvm::CachedFileStream> {
+		std::error_code errorCode;
+		auto stream = std::make_unique<llvm::raw_fd_ostream>(objectFiles[task], errorCode, llvm::sys::fs::OF_None);
+		if (errorCode) {
+			std::cout << "cannot open file " << objectFiles[task] << ": " << errorCode.message() << std::endl;
+			areObjectsWritten = false;
+
+			// LLVM aborts on the writes to a stream that failed, so the object is discarded instead
+			return std::make_unique<llvm::CachedFileStream>(std::make_unique<llvm::raw_null_ostream>(), objectFiles[task]);
+		}
+
+		return std::make_unique<llvm::CachedFileStream>(std::move(stream), objectFiles[task]);
+	});
+
+	if (error) {
+		std::cout << "LTO failed: " << llvm::toString(std::move(error)) << std::endl;
+		return;
+	}
+
+	// Some object file is missing, so none of them is saved as up to date
+	if (!areObjectsWritten) {
+		return;
+	}
+
+	for (size_t i = isThin ? 1 : 0; i < objectFiles.size(); i++) {
+		m_filesToLink.push_back(objectFiles[i]);
+	}
+
+	if (m_project.getSettings().incremental) {
+		for (Module* module : modules) {
+			saveObjectFileHash(getObjectFilePath(*module), getModuleHash(*module));
+		}
+	}
+}
+
+bool Compiler::compileLLVMModule(
 	llvm::Module* llvmModule,
 	const std::string& buildFilePath,
 	llvm::TargetMachine* targetMachine
@@ -231,45 +700,323 @@ void Compiler::compileLLVMModule(
 
 	// LLVM optimization
 	if (m_project.getSettings().optLevel != OptimizationLevel::O0) {
-		initPasses(targetMachine);
-		g_modulePassManager->run(*llvmModule, *g_moduleAnalysisManager);
+		optimizeLLVMModule(llvmModule, targetMachine);
 
 		if (m_project.getSettings().output.getOutputMode(CompilerOutput::IRAfterOpt) != CompilerOutput::NoOut) {
 			printIR(llvmModule, true);
 		}
 	}
 
-	std::error_code err_code;
-	llvm::raw_fd_ostream dest(buildFilePath, err_code, llvm::sys::fs::OF_None);
-	if (err_code) {
-		std::cout << "cannot open file: " << err_code.message();
+	m_filesToLink.push_back(buildFilePath);
+	return m_codeGenerator->emitObjectFile(*llvmModule, buildFilePath);
+}
+
+bool Compiler::compileLLVMModulePartitioned(
+	llvm::Module* llvmModule,
+	const std::vector<std::string>& buildFilePaths,
+	llvm::TargetMachine* targetMachine
+) {
+	if (m_project.getSettings().output.getOutputMode(CompilerOutput::IRBeforeOpt) != CompilerOutput::NoOut) {
+		printIR(llvmModule, false);
+	}
+
+	// The module is optimized as a whole, so that the partitioning does not prevent inlining
+	if (m_project.getSettings().optLevel != OptimizationLevel::O0) {
+		optimizeLLVMModule(llvmModule, targetMachine);
+
+		if (m_project.getSettings().output.getOutputMode(CompilerOutput::IRAfterOpt) != CompilerOutput::NoOut) {
+			printIR(llvmModule, true);
+		}
 	}
 
-	m_filesToLink.append(" " + buildFilePath);
+	// The partitions are written to the object files directly, they are only linked afterwards
+	std::vector<std::unique_ptr<llvm::raw_fd_ostream>> streams;
+	std::vector<llvm::raw_pwrite_stream*> streamPtrs;
+	for (auto& path : buildFilePaths) {
+		std::error_code errorCode;
+		streams.push_back(std::make_unique<llvm::raw_fd_ostream>(path, errorCode, llvm::sys::fs::OF_None));
+		if (errorCode) {
+			std::cout << "cannot open file " << path << ": " << errorCode.message() << std::endl;
+			return false;
+		}
 
+		streamPtrs.push_back(streams.back().get());
+	}
+
+	// Each partition is compiled in its own llvm::LLVMContext, so every thread needs its own llvm::TargetMachine
+	// The local symbols stay local (in the partition with their users), otherwise they could clash with other object files' symbols
+	TimePhase phase("Codegen", llvmModule->getModuleIdentifier());
 	llvmModule->setDataLayout(targetMachine->createDataLayout());
-	llvm::legacy::PassManager pass;
-	if (targetMachine->addPassesToEmitFile(pass, dest, nullptr, llvm::CGFT_ObjectFile)) {
-		std::cout << "targetMachine can't emit a file of this type";
+	llvm::splitCodeGen(
+		*llvmModule,
+		streamPtrs,
+		{ },
+		[this]() { return m_codeGenerator->createTargetMachine(); },
+		llvm::CGFT_ObjectFile,
+		true
+	);
+
+	bool isWritten = true;
+	for (size_t i = 0; i < buildFilePaths.size(); i++) {
+		streams[i]->close();
+		if (streams[i]->has_error()) {
+			std::cout << "cannot write file " << buildFilePaths[i] << ": " << streams[i]->error().message() << std::endl;
+			streams[i]->clear_error();
+			isWritten = false;
+		}
+
+		m_filesToLink.push_back(buildFilePaths[i]);
+	}
+
+	return isWritten;
+}
+
+void Compiler::optimizeLLVMModule(llvm::Module* llvmModule, llvm::TargetMachine* targetMachine, OptimizationPipeline pipeline) {
+	TimePhase phase("Optimize", llvmModule->getModuleIdentifier());
+
+	// The managers are local so that several modules could be optimized simultaneously
+	llvm::LoopAnalysisManager loopAnalysisManager;
+	llvm::FunctionAnalysisManager functionAnalysisManager;
+	llvm::CGSCCAnalysisManager cgsccAnalysisManager;
+	llvm::ModuleAnalysisManager moduleAnalysisManager;
+
+	llvm::PassInstrumentationCallbacks callbacks;
+	g_timeTrace.registerPassCallbacks(callbacks);
+
+	llvm::PassBuilder pb(targetMachine, llvm::PipelineTuningOptions(), getPGOOptions(), &callbacks);
+
+	pb.registerModuleAnalyses(moduleAnalysisManager);
+	pb.registerCGSCCAnalyses(cgsccAnalysisManager);
+	pb.registerFunctionAnalyses(functionAnalysisManager);
+	pb.registerLoopAnalyses(loopAnalysisManager);
+	pb.crossRegisterProxies(
+		loopAnalysisManager,
+		functionAnalysisManager,
+		cgsccAnalysisManager,
+		moduleAnalysisManager
+	);
+
+	llvm::ModulePassManager modulePassManager;
+	if (pipeline == OptimizationPipeline::PerModule) {
+		modulePassManager = pb.buildPerModuleDefaultPipeline(getLLVMOptimizationLevel());
+	} else if (pipeline == OptimizationPipeline::Functions) {
+		modulePassManager.addPass(llvm::createModuleToFunctionPassAdaptor(
+			pb.buildFunctionSimplificationPipeline(getLLVMOptimizationLevel(), llvm::ThinOrFullLTOPhase::None)
+		));
+	} else if (m_project.getSettings().lto == LTOMode::Thin) {
+		modulePassManager = pb.buildThinLTOPreLinkDefaultPipeline(getLLVMOptimizationLevel());
+	} else {
+		modulePassManager = pb.buildLTOPreLinkDefaultPipeline(getLLVMOptimizationLevel());
 	}
 
-	pass.run(*llvmModule);
-	dest.flush();
-	dest.close();
+	modulePassManager.run(*llvmModule, moduleAnalysisManager);
 }
 
+
 void Compiler::addDefaultFunctions() {
 
 }
 
-std::string Compiler::getTargetTriple() {
-	std::string result = llvm::sys::getDefaultTargetTriple();
-	std::vector<std::string> settings = split(result, '-');
+u64 Compiler::getModuleHash(Module& module) {
+	// The set is ordered, so the hash does not depend on the order of imports
+	std::set<std::string> paths;
+	if (m_project.getSettings().compilationMode == CompilationMode::Library && m_project.getSettings().lto != LTOMode::Off) {
+		// With LTO any module's code can end up in any object file
+		for (auto& other : g_moduleList.getModules()) {
+			paths.insert(other.getPath());
+		}
+	} else {
+		for (u32 id : module.getAllTheImportedModules().set_bits()) {
+			paths.insert(g_moduleList.getModule(id)->getPath());
+		}
+	}
 
+	return getBuildHash(paths);
+}
+
+u64 Compiler::getProgramHash() {
+	// All the compiled modules go to the same object file, not only the ones imported by the main one
+	std::set<std::string> paths;
+	for (auto& path : m_project.getSettings().compiledCoreModules) {
+		ModuleRef module = g_moduleList.getModule(path);
+		for (u32 id : module->getAllTheImportedModules().set_bits()) {
+			paths.insert(g_moduleList.getModule(id)->getPath());
+		}
+	}
+
+	return getBuildHash(paths);
+}
+
+u64 Compiler::getBuildHash(const std::set<std::string>& modulePaths) {
+	// Everything apart from the sources that changes the object file
+	std::string key = std::string(__DATE__ " " __TIME__) // the compiler's build
+		+ ' ' + getTargetTriple()
+		+ ' ' + getTargetCPU()
+		+ ' ' + getTargetFeatures()
+		+ ' ' + std::to_string(u32(m_project.getSettings().optLevel))
+		+ ' ' + m_project.getSettings().functionPasses
+		+ ' ' + std::to_string(u32(m_project.getSettings().configuration))
+		+ ' ' + std::to_string(u32(m_project.getSettings().compilationMode))
+		+ ' ' + std::to_string(m_project.getSettings().emitInterfaces) // the interfaces are written along with the object files
+		+ ' ' + std::to_string(u32(m_project.getSettings().lto))
+		+ ' ' + std::to_string(getProgramObjectFilePaths().size())
+		+ ' ' + std::to_string(u32(m_project.getSettings().pgoMode)) + ' ' + m_project.getSettings().pgoProfile;
+
+	// The profile drives the optimizations as much as the sources do
+	if (m_project.getSettings().pgoMode == PGOMode::Use) {
+		key += ' ' + std::to_string(getSourceHash(m_project.getSettings().pgoProfile));
+	}
+
+	for (auto& path : modulePaths) {
+		key += '\n' + path + ' ' + std::to_string(getSourceHash(path));
+	}
+
+	return llvm::xxHash64(key);
+}
+
+u64 Compiler::getSourceHash(const std::string& path) {
+	if (auto it = m_sourceHashes.find(path); it != m_sourceHashes.end()) {
+		return it->second;
+	}
+
+	// A module loaded from its interface may have no source
+	SourceBuffer* source = SourceBuffer::get(path);
+	if (!source) {
+		source = SourceBuffer::get(ModuleInterface::getInterfacePath(path));
+	}
+
+	u64 hash = source ? llvm::xxHash64(llvm::StringRef(source->getText().data(), source->getText().size())) : 0;
+	m_sourceHashes[path] = hash;
+
+	return hash;
+}
+
+std::string Compiler::getObjectFilePath(Module& module) {
+	if (auto it = m_objectFiles.find(module.getPath()); it != m_objectFiles.end()) {
+		return it->second;
+	}
+
+	// The full LTO merges all the modules into a single object file
+	std::string result;
+	if (m_project.getSettings().compilationMode == CompilationMode::Library && m_project.getSettings().lto == LTOMode::Full) {
+		result = "build/" + m_project.getSettings().projectName + ".o";
+	} else {
+		result = genBuildFilePath(module.getPath(), ".o");
+	}
+
+	m_objectFiles[module.getPath()] = result;
 
 	return result;
 }
 
+std::vector<std::string> Compiler::getProgramObjectFilePaths() {
+	std::string objectFile = m_project.getSettings().output.getOutputFile(CompilerOutput::ObjectData);
+	u32 partitions = m_project.getSettings().codegenPartitions;
+	if (partitions == 0) {
+		partitions = llvm::hardware_concurrency().compute_thread_count();
+	}
+
+	std::vector<std::string> result = { objectFile };
+	for (u32 i = 1; i < partitions; i++) {
+		result.push_back(std::filesystem::path(objectFile).replace_extension(std::to_string(i) + ".o").string());
+	}
+
+	return result;
+}
+
+bool Compiler::isObjectFileUpToDate(const std::string& objectFile, u64 hash) {
+	if (!std::filesystem::exists(objectFile)) {
+		return false;
+	}
+
+	std::ifstream file(objectFile + ".hash");
+	u64 storedHash = 0;
+	if (!(file >> storedHash)) {
+		return false;
+	}
+
+	return storedHash == hash;
+}
+
+void Compiler::saveObjectFileHash(const std::string& objectFile, u64 hash) {
+	std::ofstream file(objectFile + ".hash");
+	file << hash;
+}
+
+bool Compiler::isBuildUpToDate() {
+	std::vector<std::string> objectFiles;
+	if (m_project.getSettings().compilationMode == CompilationMode::Program) {
+		objectFiles = getProgramObjectFilePaths();
+		if (!isObjectFileUpToDate(objectFiles[0], getProgramHash())) {
+			return false;
+		}
+
+		// The hash is only stored for the first partition
+		for (auto& objectFile : objectFiles) {
+			if (!std::filesystem::exists(objectFile)) {
+				return false;
+			}
+		}
+	} else {
+		for (auto& module : g_moduleList.getModules()) {
+			if (module.getInterface()) {
+				continue;
+			}
+
+			std::string objectFile = getObjectFilePath(module);
+			if (!isObjectFileUpToDate(objectFile, getModuleHash(module))) {
+				return false;
+			}
+
+			if (std::find(objectFiles.begin(), objectFiles.end(), objectFile) == objectFiles.end()) {
+				objectFiles.push_back(std::move(objectFile));
+			}
+		}
+	}
+
+	for (auto& objectFile : objectFiles) {
+		m_filesToLink.push_back(objectFile);
+	}
+
+	return true;
+}
+
+
+std::string Compiler::getTargetTriple() {
+	ProjectSettings& settings = m_project.getSettings();
+	return llvm::Triple::normalize(
+		settings.targetArch + '-' + settings.targetVendor + '-' + settings.targetSystem + '-' + settings.targetABI
+	);
+}
+
+std::string Compiler::getTargetCPU() {
+	if (m_project.getSettings().targetCPU == "native") {
+		return llvm::sys::getHostCPUName().str();
+	}
+
+	return m_project.getSettings().targetCPU;
+}
+
+std::string Compiler::getTargetFeatures() {
+	std::string features = m_project.getSettings().targetFeatures;
+	if (features != "native" && (m_project.getSettings().targetCPU != "native" || features != "")) {
+		return features;
+	}
+
+	// The host's features, both for "target-features": "native" and for "target-cpu": "native" without explicit features
+	llvm::StringMap<bool> hostFeatures;
+	if (!llvm::sys::getHostCPUFeatures(hostFeatures)) {
+		return "";
+	}
+
+	llvm::SubtargetFeatures result;
+	for (auto& feature : hostFeatures) {
+		result.AddFeature(feature.getKey(), feature.getValue());
+	}
+
+	return result.getString();
+}
+
 std::string Compiler::genBuildFilePath(const std::string& modulePath, const std::string& extension) {
 	static std::set<std::string> s_generatedNames;
 	std::string moduleName = Module::getModuleNameFromPath(modulePath);
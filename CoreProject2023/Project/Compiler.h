@@ -1,46 +1,124 @@
 #pragma once
 #include <set>
+#include <map>
 #include <memory>
+#include <llvm/ADT/Optional.h>
+#include <llvm/Support/PGOOptions.h>
 #include "Project.h"
 
 struct Token;
 class Declaration;
+class Module;
+class CodeGenerator;
 
 namespace llvm {
 	class TargetMachine;
 	class Module;
+	class OptimizationLevel;
 }
 
 class Compiler final {
 private:
 	Project& m_project;
+	std::unique_ptr<CodeGenerator> m_codeGenerator; // its target machine also gives the target's costs to the global analyses
 	std::set<std::string> m_builtModules;
-	std::string m_filesToLink;
+	std::vector<std::string> m_filesToLink;
+	std::vector<std::pair<std::string, u64>> m_moduleTokenCounts; // module path -> number of its tokens, for --stats
+
+	// For the incremental build
+	std::map<std::string, u64> m_sourceHashes; // source file path -> hash of its text
+	std::map<std::string, std::string> m_objectFiles; // module path -> object file path (in library mode)
 
 public:
 	Compiler(Project& project);
+	~Compiler();
 
 	// In such order only
 	void buildProject();
 	void linkProject();
 	void runProject();
 
+	// Instead of the above: compiles the program and runs it in-process with ORC LLJIT, returns the exit code of main
+	// The functions are compiled lazily, when they are called for the first time
+	i32 runProjectJIT();
+
+	// Prints the counters of the compiler's work and the number of tokens of each module (option --stats)
+	void printStatistics();
+
 private:
 	void initAll();
-	void initPasses(llvm::TargetMachine* machine = nullptr);
+	void initPasses();
+	llvm::OptimizationLevel getLLVMOptimizationLevel();
+	llvm::Optional<llvm::PGOOptions> getPGOOptions();
 
 	void preloadSymbols(const std::string& path);
 	void compileModules();
 	void compileLLVM();
-	void compileLLVMModule(
+
+	// Optimizes and emits the library modules on several threads, each with its own llvm::LLVMContext
+	// The front end is sequential: the modules share the symbols, the types and the global llvm::LLVMContext
+	void compileLLVMModulesInParallel(const std::string& targetTriple);
+
+	// Compiles the library modules through llvm::lto::LTO (ThinLTO backends run on several threads)
+	void compileLLVMModulesWithLTO(const std::string& targetTriple, llvm::TargetMachine* targetMachine);
+
+	// Returns false if the object file was not written
+	bool compileLLVMModule(
 		llvm::Module* llvmModule,
 		const std::string& buildFilePath,
 		llvm::TargetMachine* targetMachine
 	);
 
+	// Splits the module into partitions and emits an object file for each of them on several threads
+	// Returns false if any of the object files was not written
+	bool compileLLVMModulePartitioned(
+		llvm::Module* llvmModule,
+		const std::vector<std::string>& buildFilePaths,
+		llvm::TargetMachine* targetMachine
+	);
+
+	enum class OptimizationPipeline : u8 {
+		PerModule,
+		LTOPreLink, // only the pre-link part, the rest is done by llvm::lto::LTO
+		Functions // only the function simplification, for the parts of the module compiled lazily by JIT
+	};
+
+	// Thread-safe as long as each thread has its own llvm::LLVMContext and llvm::TargetMachine
+	void optimizeLLVMModule(
+		llvm::Module* llvmModule,
+		llvm::TargetMachine* targetMachine,
+		OptimizationPipeline pipeline = OptimizationPipeline::PerModule
+	);
+
 	void addDefaultFunctions();
 
+	// Incremental build
+	// The hash of the module's source, the sources of all its imports and the settings the object file depends on
+	u64 getModuleHash(Module& module);
+
+	// The same for the program's object files, they contain all the compiled modules
+	u64 getProgramHash();
+
+	// The hash of the sources of the modules and the settings the object files depend on
+	u64 getBuildHash(const std::set<std::string>& modulePaths);
+	u64 getSourceHash(const std::string& path);
+	std::string getObjectFilePath(Module& module);
+
+	// The object files of a program: the output object file and -name-.N.o next to it for the other codegen partitions
+	std::vector<std::string> getProgramObjectFilePaths();
+
+	// Checks the hash stored next to the object file
+	bool isObjectFileUpToDate(const std::string& objectFile, u64 hash);
+	void saveObjectFileHash(const std::string& objectFile, u64 hash);
+
+	// Returns true if all the object files are up to date, adds them to the linked files then
+	bool isBuildUpToDate();
+
 	std::string getTargetTriple();
+
+	// The settings' CPU and features with "native" replaced by the host's ones
+	std::string getTargetCPU();
+	std::string getTargetFeatures();
 	std::string genBuildFilePath(const std::string& modulePath, const std::string& extension);
 
 private:
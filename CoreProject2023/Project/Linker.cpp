@@ -0,0 +1,145 @@
+#include "Linker.h"
+#include <iostream>
+#include <filesystem>
+#include <llvm/ADT/Triple.h>
+#include <llvm/Support/raw_ostream.h>
+
+// lld is optional, without it the external linker is always used
+#if __has_include(<lld/Common/Driver.h>)
+#define CORE_HAS_LLD
+#include <lld/Common/Driver.h>
+#include <lld/Common/CommonLinkerContext.h>
+#endif
+
+Linker::Linker(std::string targetTriple, std::string outputFile, std::vector<std::string> files)
+	: m_targetTriple(std::move(targetTriple)), m_outputFile(std::move(outputFile)), m_files(std::move(files)) {
+
+}
+
+bool Linker::link(LinkerMode mode, bool isInstrumented) {
+	// The profile runtime of an instrumented program is only found by clang++
+	if (mode == LinkerMode::Internal && !isInstrumented) {
+#ifdef CORE_HAS_LLD
+		llvm::Triple triple(m_targetTriple);
+		std::vector<std::string> args;
+		if (triple.isOSBinFormatCOFF() && getCOFFArgs(args)) {
+			return linkWithLLD(args, true);
+		} else if (triple.isOSBinFormatELF() && getELFArgs(args)) {
+			return linkWithLLD(args, false);
+		}
+
+		std::cout << "warning: the internal linker cannot link for " << m_targetTriple << ", clang++ is used instead" << std::endl;
+#else
+		std::cout << "warning: the compiler was built without lld, clang++ is used instead of the internal linker" << std::endl;
+#endif
+	}
+
+	return linkWithExternalLinker(isInstrumented);
+}
+
+bool Linker::getCOFFArgs(std::vector<std::string>& args) {
+	if (!llvm::Triple(m_targetTriple).isKnownWindowsMSVCEnvironment()) {
+		return false;
+	}
+
+	// The C runtime is found through the LIB environment variable or the installed MSVC
+	args = { "lld-link", "/nologo", "/out:" + m_outputFile, "/subsystem:console", "/defaultlib:libcmt", "/defaultlib:oldnames" };
+	args.insert(args.end(), m_files.begin(), m_files.end());
+
+	return true;
+}
+
+bool Linker::getELFArgs(std::vector<std::string>& args) {
+	llvm::Triple triple(m_targetTriple);
+	if (!triple.isOSLinux() || !triple.isGNUEnvironment()) {
+		return false;
+	}
+
+	std::string dynamicLinker;
+	std::string multiarch; // the name of the target's directories in Debian-like systems
+	switch (triple.getArch()) {
+		case llvm::Triple::x86_64: dynamicLinker = "/lib64/ld-linux-x86-64.so.2"; multiarch = "x86_64-linux-gnu"; break;
+		case llvm::Triple::x86: dynamicLinker = "/lib/ld-linux.so.2"; multiarch = "i386-linux-gnu"; break;
+		case llvm::Triple::aarch64: dynamicLinker = "/lib/ld-linux-aarch64.so.1"; multiarch = "aarch64-linux-gnu"; break;
+	default: return false;
+	}
+
+	// The start files of the C runtime
+	std::string crtDir;
+	for (const std::string& dir : { "/usr/lib/" + multiarch, std::string(triple.isArch64Bit() ? "/usr/lib64" : "/usr/lib32"), std::string("/usr/lib") }) {
+		if (std::filesystem::exists(dir + "/crt1.o")) {
+			crtDir = dir;
+			break;
+		}
+	}
+
+	if (crtDir.empty()) {
+		return false;
+	}
+
+	// libgcc has the functions LLVM may generate calls to (e.g. 128-bit division), it is in the directory of the latest GCC
+	std::string gccDir;
+	std::string gccVersion;
+	for (const std::string& dir : { "/usr/lib/gcc/" + multiarch, "/usr/lib/gcc/" + m_targetTriple }) {
+		std::error_code errorCode;
+		for (auto& entry : std::filesystem::directory_iterator(dir, errorCode)) {
+			// The directories are named by the versions, so "12" must be later than "9"
+			std::string version = entry.path().filename().string();
+			bool isLater = version.size() != gccVersion.size() ? version.size() > gccVersion.size() : version > gccVersion;
+			if (isLater && std::filesystem::exists(entry.path() / "libgcc.a")) {
+				gccDir = entry.path().string();
+				gccVersion = version;
+			}
+		}
+	}
+
+	args = { "ld.lld", "-o", m_outputFile, "--eh-frame-hdr", "-dynamic-linker", dynamicLinker, crtDir + "/crt1.o", crtDir + "/crti.o" };
+	args.insert(args.end(), m_files.begin(), m_files.end());
+	args.push_back("-L" + crtDir);
+	if (!gccDir.empty()) {
+		args.insert(args.end(), { "-L" + gccDir, "-lgcc", "--as-needed", "-lgcc_s", "--no-as-needed" });
+	}
+
+	args.insert(args.end(), { "-lm", "-lc", crtDir + "/crtn.o" });
+
+	return true;
+}
+
+bool Linker::linkWithLLD(const std::vector<std::string>& args, bool isCOFF) {
+#ifdef CORE_HAS_LLD
+	std::vector<const char*> argv;
+	for (auto& arg : args) {
+		argv.push_back(arg.c_str());
+	}
+
+	// lld prints its errors itself and must not exit the compiler on them
+	bool isLinked = isCOFF
+		? lld::coff::link(argv, llvm::outs(), llvm::errs(), false, false)
+		: lld::elf::link(argv, llvm::outs(), llvm::errs(), false, false);
+
+	lld::CommonLinkerContext::destroy();
+	return isLinked;
+#else
+	return false;
+#endif
+}
+
+bool Linker::linkWithExternalLinker(bool isInstrumented) {
+#ifdef _WIN32
+	std::string command = "clang++.exe -o " + m_outputFile;
+#else
+	std::string command = "clang++ -o " + m_outputFile;
+#endif
+
+	for (auto& file : m_files) {
+		command += ' ';
+		command += file;
+	}
+
+	// The instrumented code needs the profile runtime
+	if (isInstrumented) {
+		command += " -fprofile-generate";
+	}
+
+	return system(command.c_str()) == 0;
+}
@@ -0,0 +1,34 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "ProjectSettings.h"
+
+/*
+	Links the object files into the executable.
+	The internal linker is lld linked into the compiler, so no process is spawned:
+	lld-link for Windows (MSVC), ld.lld for the ELF systems with glibc.
+	The external linker is clang++ run through the shell. It is used in case of "linker": "external",
+	if the compiler was built without lld, or if lld cannot link for the target (e.g. the C runtime is not found);
+	in the last two cases a warning is printed.
+*/
+
+class Linker final {
+private:
+	std::string m_targetTriple;
+	std::string m_outputFile;
+	std::vector<std::string> m_files;
+
+public:
+	Linker(std::string targetTriple, std::string outputFile, std::vector<std::string> files);
+
+	// Returns true if the executable was linked
+	bool link(LinkerMode mode, bool isInstrumented);
+
+private:
+	// Return false if lld cannot link for the target
+	bool getCOFFArgs(std::vector<std::string>& args);
+	bool getELFArgs(std::vector<std::string>& args);
+
+	bool linkWithLLD(const std::vector<std::string>& args, bool isCOFF);
+	bool linkWithExternalLinker(bool isInstrumented);
+};
@@ -56,6 +56,12 @@ void ProjectFileParser::loadSettingsFromFile(const std::string& fileName) {
 			-1,
 			"the output object file (\"output\": { \"object-data\" })"
 		);
+	} else if (m_settings.pgoMode == PGOMode::Use && m_settings.pgoProfile == "") {
+		ErrorManager::projectSettingsError(
+			ErrorID::E5005_NECESSARY_SETTING_NOT_FOUND,
+			-1,
+			"the profile file (\"pgo\": { \"profile\" })"
+		);
 	}
 }
 
@@ -108,12 +114,49 @@ void ProjectFileParser::loadSettings(void* jsonData) {
 			m_settings.targetSystem = getJsonAs(value, json::value_t::string, key);
 		} else if (key == "target-abi") {
 			m_settings.targetABI = getJsonAs(value, json::value_t::string, key);
+		} else if (key == "target-cpu") {
+			m_settings.targetCPU = getJsonAs(value, json::value_t::string, key);
+		} else if (key == "target-features") {
+			m_settings.targetFeatures = getJsonAs(value, json::value_t::string, key);
 		} else if (key == "opt-level") {
 			const json& d = getJsonAs(value, json::value_t::number_unsigned, key);
 			m_settings.optLevel = OptimizationLevel(getJsonVariant(d, { "0", "1", "2", "3" }, key));
 		} else if (key == "compilation-mode") {
 			const json& d = getJsonAs(value, json::value_t::string, key);
 			m_settings.compilationMode = CompilationMode(getJsonVariant(d, { "program", "library" }, key));
+		} else if (key == "lto") {
+			const json& d = getJsonAs(value, json::value_t::string, key);
+			m_settings.lto = LTOMode(getJsonVariant(d, { "off", "thin", "full" }, key));
+		} else if (key == "linker") {
+			const json& d = getJsonAs(value, json::value_t::string, key);
+			m_settings.linker = LinkerMode(getJsonVariant(d, { "internal", "external" }, key));
+		} else if (key == "pgo") {
+			for (auto& [ pgoKey, val ] : getJsonAs(value, json::value_t::object, key).items()) {
+				if (pgoKey == "mode") {
+					const json& d = getJsonAs(val, json::value_t::string, pgoKey);
+					m_settings.pgoMode = PGOMode(getJsonVariant(d, { "off", "instrument", "use" }, key));
+				} else if (pgoKey == "profile") {
+					m_settings.pgoProfile = getAbsolutePath(getJsonAs(val, json::value_t::string, "profile file"));
+				} else {
+					ErrorManager::projectSettingsError(
+						ErrorID::E5001_UNKNOWN_SETTING,
+						-1,
+						key + ": " + pgoKey + " - no such setting"
+					);
+				}
+			}
+		} else if (key == "function-passes") {
+			m_settings.functionPasses = getJsonAs(value, json::value_t::string, key);
+		} else if (key == "jobs") {
+			m_settings.jobs = u32(getJsonAs(value, json::value_t::number_unsigned, key));
+		} else if (key == "codegen-partitions") {
+			m_settings.codegenPartitions = u32(getJsonAs(value, json::value_t::number_unsigned, key));
+		} else if (key == "incremental") {
+			m_settings.incremental = getJsonAs(value, json::value_t::boolean, key);
+		} else if (key == "emit-interfaces") {
+			m_settings.emitInterfaces = getJsonAs(value, json::value_t::boolean, key);
+		} else if (key == "use-interfaces") {
+			m_settings.useInterfaces = getJsonAs(value, json::value_t::boolean, key);
 		} else if (key == "output") {
 			for (auto& [ stageStr, val ] : getJsonAs(value, json::value_t::object, key).items()) {
 				const json& d = getJsonAs(val, json::value_t::array, stageStr);
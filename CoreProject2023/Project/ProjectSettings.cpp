@@ -30,7 +30,17 @@ ProjectSettings::ProjectSettings()
  :
 	configuration(Configuration::Debug),
 	optLevel(OptimizationLevel::O2),
-	compilationMode(CompilationMode::Program) {
+	compilationMode(CompilationMode::Program),
+	lto(LTOMode::Off),
+	pgoMode(PGOMode::Off),
+	linker(LinkerMode::Internal),
+	functionPasses("sroa,early-cse,simplifycfg,instcombine"),
+	jobs(1),
+	codegenPartitions(1),
+	incremental(false),
+	emitInterfaces(false),
+	useInterfaces(false),
+	targetCPU("generic") {
 	std::vector<std::string> triple = split(llvm::sys::getDefaultTargetTriple(), '-');
 
 	if (triple.size()) {
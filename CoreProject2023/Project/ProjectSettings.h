@@ -19,6 +19,25 @@ enum class CompilationMode : u8 {
 	Library
 };
 
+// Link-time optimization of the library's modules
+enum class LTOMode : u8 {
+	Off = 0,
+	Thin, // the modules are optimized separately, importing the functions they use from the other modules
+	Full // the modules are merged and optimized as a single one
+};
+
+enum class LinkerMode : u8 {
+	Internal = 0, // lld inside the compiler
+	External // clang++
+};
+
+// Profile-guided optimization
+enum class PGOMode : u8 {
+	Off = 0,
+	Instrument, // the program writes the profile of its run
+	Use // the optimizations are driven by the merged profile (.profdata)
+};
+
 // For each stage there can be
 struct CompilerOutput {
 	enum OutputStage : u8 {
@@ -55,12 +74,25 @@ struct ProjectSettings {
 	Configuration configuration;
 	OptimizationLevel optLevel;
 	CompilationMode compilationMode;
+	LTOMode lto;
+	PGOMode pgoMode;
+	LinkerMode linker;
+	std::string functionPasses; // the LLVM pipeline run on each function right after its generation
+	std::string pgoProfile; // the profile to be written (Instrument, optional) or read (Use)
 	CompilerOutput output;
 
+	u32 jobs; // the number of threads optimizing and emitting a library's modules, 0 means all the hardware threads
+	u32 codegenPartitions; // the number of parts of a program's module compiled simultaneously, 0 means all the hardware threads
+	bool incremental; // reuse the object files of the modules that did not change since the last build
+	bool emitInterfaces; // write a module interface (.coreif) next to each compiled module, library only
+	bool useInterfaces; // load the imported modules from their interfaces instead of the sources
+
 	std::string targetArch;
 	std::string targetVendor;
 	std::string targetSystem;
 	std::string targetABI;
+	std::string targetCPU; // "native" means the host's CPU
+	std::string targetFeatures; // like "+avx2,-fma", "native" means the host's features
 
 	std::string projectName;
 	std::vector<std::string> additionalImportDirs;
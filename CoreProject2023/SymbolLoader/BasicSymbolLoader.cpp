@@ -81,7 +81,7 @@ void BasicSymbolLoader::readAnnotations() {
 		m_annots.push_back(std::vector<std::string>());
 
 		while (m_pos < m_toks.size() && m_toks[m_pos].errLine == line) {
-			m_annots.back().push_back(m_toks[m_pos++].data);
+			m_annots.back().push_back(m_toks[m_pos++].data());
 		}
 	}
 }
@@ -36,12 +36,12 @@ SymbolLoader::SymbolLoader(std::vector<Token>& toks, const std::string& path)
 
 void SymbolLoader::loadUse() {
 	std::string moduleName = "";
-	std::string name = consume(TokenType::WORD).data;
+	std::string name = consume(TokenType::WORD).data();
 	SymbolType symType = g_module->getSymbolType(name);
 
 	if (symType == SymbolType::MODULE && match(TokenType::DOT)) {
 		moduleName = std::move(name);
-		name = consume(TokenType::WORD).data;
+		name = consume(TokenType::WORD).data();
 		symType = g_module->getSymbolType(moduleName, name);
 	}
 
@@ -57,7 +57,7 @@ void SymbolLoader::loadUse() {
 
 	std::string alias = "";
 	if (match(TokenType::AS)) {
-		alias = consume(TokenType::WORD).data;
+		alias = consume(TokenType::WORD).data();
 	}
 
 	g_module->addAlias(symType, moduleName, name, alias);
@@ -69,8 +69,8 @@ void SymbolLoader::loadClass() {
 	std::shared_ptr<TypeNode> typeNode = m_symbols.getType(m_pos);
 
 	if (match(TokenType::STRUCT)) {
-		std::string name = consume(TokenType::WORD).data;
-		std::vector<std::shared_ptr<Type>> fieldTypes;
+		std::string name = consume(TokenType::WORD).data();
+		std::vector<Type*> fieldTypes;
 		consume(TokenType::LBRACE);
 
 		std::vector<Variable> fields;
@@ -92,9 +92,9 @@ void SymbolLoader::loadClass() {
 			}
 		}
 
-		std::shared_ptr<StructType> type = StructType::createType(std::move(fieldTypes));
+		StructType* type = StructType::createType(std::move(fieldTypes));
 		typeNode->llvmType = type->to_llvm();
-		typeNode->type = std::move(type);
+		typeNode->type = type;
 		typeNode->fields = std::move(fields);
 		typeNode->methods = std::move(methods);
 	}
@@ -106,7 +106,7 @@ void SymbolLoader::loadFunction() {
 	// read function declaration
 	match(TokenType::NATIVE);
 
-	std::shared_ptr<Type> returnType;
+	Type* returnType = nullptr;
 	if (match(TokenType::TYPE)) { // constructor
 		returnType = TypeParser(m_toks, m_pos).consumeType();
 	} else if (!match(TokenType::WORD)) {
@@ -134,21 +134,21 @@ void SymbolLoader::loadFunction() {
 					);
 				}
 			} else {
-				std::shared_ptr<Type> type = TypeParser(m_toks, m_pos).consumeType();
+				Type* type = TypeParser(m_toks, m_pos).consumeType();
 				consume(TokenType::WORD);
-				args.push_back(Argument{ m_toks[m_pos - 1].data, std::move(type) });
+				args.push_back(Argument{ m_toks[m_pos - 1].data(), type });
 			}
 		} while (match(TokenType::COMMA));
 
 		consume(TokenType::RPAR);
 	}
 
-	func->prototype.args() = std::move(args);
+	func->prototype.setArgs(std::move(args));
 
 	if (!returnType) { // not a constructor
-		func->prototype.getReturnType() = TypeParser(m_toks, m_pos).parseTypeOrGetNoType();
+		func->prototype.setReturnType(TypeParser(m_toks, m_pos).parseTypeOrGetNoType());
 	} else { // constructor
-		func->prototype.getReturnType() = std::move(returnType);
+		func->prototype.setReturnType(returnType);
 	}
 
 	// skip code
@@ -187,7 +187,7 @@ void SymbolLoader::loadVariable() {
 void SymbolLoader::loadTypeVariable() {
 	TypeNode* typeNode = m_symbols.getType(m_pos).get();
 
-	std::string alias = consume(TokenType::WORD).data;
+	std::string alias = consume(TokenType::WORD).data();
 	consume(TokenType::EQ);
 
 	typeNode->type = TypeParser(m_toks, m_pos).consumeType();
@@ -248,7 +248,7 @@ std::optional<FunctionPrototype> SymbolLoader::loadMethod(TypeQualities parentQu
 	qualities.setNative(match(TokenType::NATIVE));
 
 	std::string alias;
-	std::shared_ptr<Type> returnType;
+	Type* returnType = nullptr;
 	TokenType opType = TokenType::NO_TOKEN; // for operators
 	if (match(TokenType::TYPE)) {
 		returnType = TypeParser(m_toks, m_pos).consumeType();
@@ -274,10 +274,10 @@ std::optional<FunctionPrototype> SymbolLoader::loadMethod(TypeQualities parentQu
 			);
 		}
 	} else if (match(TokenType::WORD)) {
-		alias = peek(-1).data;
+		alias = peek(-1).data();
 	} else if (DEFINABLE_OPERATORS.contains(m_toks[m_pos].type)) { // operator-functions
 		qualities.setFunctionKind(FunctionKind::OPERATOR);
-		alias = m_toks[m_pos].data;
+		alias = m_toks[m_pos].data();
 		opType = m_toks[m_pos].type;
 		if (m_toks[m_pos].type == TokenType::LPAR || m_toks[m_pos].type == TokenType::LBRACKET) {
 			m_pos++;
@@ -308,9 +308,9 @@ std::optional<FunctionPrototype> SymbolLoader::loadMethod(TypeQualities parentQu
 
 				isVaArgs = true;
 			} else {
-				std::shared_ptr<Type> type = TypeParser(m_toks, m_pos).consumeType();
+				Type* type = TypeParser(m_toks, m_pos).consumeType();
 				consume(TokenType::WORD);
-				args.push_back(Argument{ m_toks[m_pos - 1].data, std::move(type) });
+				args.push_back(Argument{ m_toks[m_pos - 1].data(), type });
 			}
 		} while (match(TokenType::COMMA));
 
@@ -334,7 +334,7 @@ std::optional<FunctionPrototype> SymbolLoader::loadMethod(TypeQualities parentQu
 	if (qualities.getFunctionKind() == FunctionKind::CONSTRUCTOR) {
 		m_symbols.addConstructor(
 			qualities.getVisibility(),
-			FunctionPrototype(alias, std::move(returnType), std::move(args), qualities, isVaArgs),
+			FunctionPrototype(alias, returnType, std::move(args), qualities, isVaArgs),
 			tokenPos
 		);
 
@@ -350,13 +350,13 @@ std::optional<FunctionPrototype> SymbolLoader::loadMethod(TypeQualities parentQu
 
 		m_symbols.addOperator(
 			qualities.getVisibility(),
-			FunctionPrototype(alias, std::move(returnType), std::move(args), qualities, isVaArgs),
+			FunctionPrototype(alias, returnType, std::move(args), qualities, isVaArgs),
 			tokenPos
 		);
 
 		return std::nullopt;
 	} else {
-		return { FunctionPrototype(alias, std::move(returnType), std::move(args), qualities, isVaArgs) };
+		return { FunctionPrototype(alias, returnType, std::move(args), qualities, isVaArgs) };
 	}
 }
 
@@ -371,8 +371,8 @@ Variable SymbolLoader::loadField(TypeQualities parentQualities, std::shared_ptr<
 	}
 
 	bool isStatic = match(TokenType::STATIC);
-	std::shared_ptr<Type> type = TypeParser(m_toks, m_pos).consumeType();
-	std::string fieldName = consume(TokenType::WORD).data;
+	Type* type = TypeParser(m_toks, m_pos).consumeType();
+	std::string fieldName = consume(TokenType::WORD).data();
 
 	if (match(TokenType::EQ)) {
 		skipAssignment();
@@ -385,5 +385,5 @@ Variable SymbolLoader::loadField(TypeQualities parentQualities, std::shared_ptr<
 	fieldQualities.setVisibility(visibility);
 	fieldQualities.setVariableType(isStatic ? VariableType::COMMON : VariableType::FIELD);
 
-	return Variable(fieldName, std::move(type), fieldQualities, nullptr);
+	return Variable(fieldName, type, fieldQualities, nullptr);
 }
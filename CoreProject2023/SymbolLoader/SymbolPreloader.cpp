@@ -38,7 +38,7 @@ void SymbolPreloader::loadClass() {
 	}
 
 	if (match(TokenType::STRUCT)) {
-		std::string name = consume(TokenType::WORD).data;
+		std::string name = consume(TokenType::WORD).data();
 		consume(TokenType::LBRACE);
 
 		while (!match(TokenType::RBRACE)) {
@@ -129,10 +129,10 @@ void SymbolPreloader::loadFunction() {
 		qualities.setFunctionKind(FunctionKind::CONSTRUCTOR);
 		TypeParser(m_toks, m_pos).skipConsumeType();
 	} else if (match(TokenType::WORD)) { // common function
-		alias = m_toks[m_pos - 1].data;
+		alias = m_toks[m_pos - 1].data();
 	} else if (DEFINABLE_OPERATORS.contains(m_toks[m_pos].type)) { // operator-functions
 		qualities.setFunctionKind(FunctionKind::OPERATOR);
-		alias = m_toks[m_pos].data;
+		alias = m_toks[m_pos].data();
 		opType = m_toks[m_pos].type;
 		if (m_toks[m_pos].type == TokenType::LPAR || m_toks[m_pos].type == TokenType::LBRACKET) {
 			m_pos++;
@@ -264,7 +264,7 @@ void SymbolPreloader::loadVariable() {
 	}
 
 	TypeParser(m_toks, m_pos).skipConsumeType();
-	std::string alias = consume(TokenType::WORD).data;
+	std::string alias = consume(TokenType::WORD).data();
 
 	m_symbols.addVariable(qualities.getVisibility(), alias, qualities, tokenPos);
 
@@ -299,7 +299,7 @@ void SymbolPreloader::loadTypeVariable() {
 		);
 	}
 
-	std::string alias = consume(TokenType::WORD).data;
+	std::string alias = consume(TokenType::WORD).data();
 	consume(TokenType::EQ);
 
 	TypeParser(m_toks, m_pos).skipConsumeType();
@@ -1,5 +1,5 @@
 #include "ErrorManager.h"
-#include "String.h"
+#include "SourceBuffer.h"
 
 std::string g_currFileName = "";
 std::string g_currFilePath = "";
@@ -81,6 +81,7 @@ std::string ErrorIDStrings[] = {
 	"E4051: Loading module symbols twice; symbols of the module with such name were already loaded",
 	"E4052: No module found with such alias; trying to get a symbol of module with a wrong alias",
 	"E4053: No module found with such path; trying to set nullptr as the current module",
+	"E4054: Broken module interface; the .coreif file is corrupted or refers to a missing type",
 
 
 	"E5001: Unknown project setting",
@@ -192,39 +193,16 @@ void ErrorManager::printFileLine(int line) {
 		return;
 	}
 
-	std::ifstream file(g_currFilePath);
-	std::string tmp;
-	size_t i = 0;
-	while (std::getline(file, tmp)) {
-		if (i == line) {
-			if (_mode & CONSOLE) {
-				std::cout << tmp << std::endl;
-			} if (_mode & LOGS) {
-				ASSERT(_file == nullptr, "");
-				(*_file) << tmp << std::endl;
-			}
-
-			break;
-		}
-
-		if (size_t off = std::count(tmp.begin(), tmp.end(), '\r')) {
-			if (i + off >= line) {
-				std::vector<std::string> splitted = split(tmp, '\r');
-				if (_mode & CONSOLE) {
-					std::cout << splitted[line - i] << std::endl;
-				} if (_mode & LOGS) {
-					ASSERT(_file == nullptr, "");
-					(*_file) << splitted[line - i] << std::endl;
-				}
-
-				break;
-			}
-
-			i += off;
-		}
-
-		i++;
+	SourceBuffer* source = SourceBuffer::get(g_currFilePath);
+	if (source == nullptr) {
+		return;
 	}
 
-	file.close();
+	std::string_view text = source->getLine(u64(line));
+	if (_mode & CONSOLE) {
+		std::cout << text << std::endl;
+	} if (_mode & LOGS) {
+		ASSERT(_file == nullptr, "");
+		(*_file) << text << std::endl;
+	}
 }
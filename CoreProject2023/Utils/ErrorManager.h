@@ -88,6 +88,7 @@ enum ErrorID : u32 {
 	E4051_LOADING_MODULE_SYMBOLS_TWICE, // The module symbols were added to symbol table twice
 	E4052_NO_MODULE_FOUND_BY_ALIAS, // Tried to get symbol of module with a wrong alias
 	E4053_CANNOT_SET_NO_MODULE_AS_CURRENT, // Tried to set g_module to nullptr (since no module was found)
+	E4054_BROKEN_MODULE_INTERFACE, // The module interface file (.coreif) is corrupted or refers to a missing type
 
 
 	// Project settings errors
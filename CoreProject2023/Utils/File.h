@@ -1,7 +1,6 @@
 #pragma once
 #include <string>
 
-std::string readFile(const std::string& file);
 void createFileIfNotExists(const std::string& file);
 
 // Second path must be relative
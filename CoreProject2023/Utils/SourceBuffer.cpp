@@ -0,0 +1,59 @@
+#include "SourceBuffer.h"
+#include <map>
+
+static std::map<std::string, std::unique_ptr<SourceBuffer>> s_sourceBuffers;
+
+SourceBuffer::SourceBuffer(std::unique_ptr<llvm::MemoryBuffer> buffer)
+	: m_buffer(std::move(buffer)) {
+
+}
+
+SourceBuffer* SourceBuffer::get(const std::string& path) {
+	if (auto it = s_sourceBuffers.find(path); it != s_sourceBuffers.end()) {
+		return it->second.get();
+	}
+
+	llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> buffer = llvm::MemoryBuffer::getFile(path, false, true);
+	if (!buffer) {
+		return nullptr;
+	}
+
+	std::unique_ptr<SourceBuffer>& result = s_sourceBuffers[path];
+	result = std::make_unique<SourceBuffer>(std::move(*buffer));
+
+	return result.get();
+}
+
+std::string_view SourceBuffer::getText() const {
+	return std::string_view(m_buffer->getBufferStart(), m_buffer->getBufferSize());
+}
+
+std::string_view SourceBuffer::getLine(u64 line) {
+	if (m_lineOffsets.empty()) {
+		buildLineOffsets();
+	}
+
+	if (line >= m_lineOffsets.size()) {
+		return "";
+	}
+
+	std::string_view text = getText();
+	u64 start = m_lineOffsets[line];
+	u64 end = line + 1 < m_lineOffsets.size() ? m_lineOffsets[line + 1] : text.size();
+	while (end > start && (text[end - 1] == '\n' || text[end - 1] == '\r')) {
+		end--;
+	}
+
+	return text.substr(start, end - start);
+}
+
+void SourceBuffer::buildLineOffsets() {
+	std::string_view text = getText();
+
+	m_lineOffsets.push_back(0);
+	for (u64 i = 0; i < text.size(); i++) {
+		if (text[i] == '\n' || (text[i] == '\r' && (i + 1 == text.size() || text[i + 1] != '\n'))) {
+			m_lineOffsets.push_back(i + 1);
+		}
+	}
+}
@@ -0,0 +1,36 @@
+#pragma once
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <llvm/Support/MemoryBuffer.h>
+#include "Defs.h"
+
+/*
+	The text of a source file.
+	The file is memory-mapped when possible (llvm::MemoryBuffer reads it otherwise),
+	the text is always null-terminated.
+	Line endings are kept as is: \n, \r\n and \r are all handled by Lexer.
+	The buffers are cached by path, so that the errors could print source lines without reading the file again.
+*/
+
+class SourceBuffer final {
+private:
+	std::unique_ptr<llvm::MemoryBuffer> m_buffer;
+	std::vector<u64> m_lineOffsets; // offsets of the lines' beginnings, built on the first call to getLine
+
+public:
+	SourceBuffer(std::unique_ptr<llvm::MemoryBuffer> buffer);
+
+	// Returns the buffer of the file, opens the file if it was not opened yet
+	// Returns nullptr if the file cannot be read
+	static SourceBuffer* get(const std::string& path);
+
+	std::string_view getText() const;
+
+	// Line is counted from 0, as in Token::errLine
+	std::string_view getLine(u64 line);
+
+private:
+	void buildLineOffsets();
+};
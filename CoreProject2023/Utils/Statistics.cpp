@@ -0,0 +1,45 @@
+#include "Statistics.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <algorithm>
+
+#ifndef CORE_DISABLE_STATISTICS
+
+Statistic* Statistic::s_first = nullptr;
+
+// The counters are static objects, so they are registered before main() and never destroyed
+Statistic::Statistic(const char* group, const char* description)
+	: m_group(group), m_description(description), m_next(s_first) {
+	s_first = this;
+}
+
+u64 Statistic::getValue() const {
+	return m_value.load(std::memory_order_relaxed);
+}
+
+void Statistic::printAll() {
+	std::vector<const Statistic*> statistics;
+	for (const Statistic* statistic = s_first; statistic; statistic = statistic->m_next) {
+		statistics.push_back(statistic);
+	}
+
+	std::sort(statistics.begin(), statistics.end(), [](const Statistic* a, const Statistic* b) {
+		i32 cmp = std::string(a->m_group).compare(b->m_group);
+		return cmp != 0 ? cmp < 0 : std::string(a->m_description) < b->m_description;
+	});
+
+	std::cout << "Statistics:" << std::endl;
+	for (const Statistic* statistic : statistics) {
+		std::cout << std::right << std::setw(12) << statistic->getValue() << ' '
+			<< std::left << std::setw(12) << statistic->m_group << " - " << statistic->m_description << std::endl;
+	}
+}
+
+#else
+
+void Statistic::printAll() {
+	std::cout << "Statistics are disabled (the compiler was built with CORE_DISABLE_STATISTICS)" << std::endl;
+}
+
+#endif
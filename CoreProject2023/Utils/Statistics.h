@@ -0,0 +1,62 @@
+#pragma once
+#include <atomic>
+#include <string>
+#include "Defs.h"
+
+/*
+	Counters of the compiler's work (option --stats), in the manner of LLVM's STATISTIC.
+	A counter is declared in the .cpp file that updates it:
+		STATISTIC(NumTokens, "lexer", "tokens produced");
+		...
+		NumTokens += toks.size();
+	All the counters register themselves and are printed by Statistic::printAll().
+	The counters are compiled out if CORE_DISABLE_STATISTICS is defined.
+*/
+
+#ifndef CORE_DISABLE_STATISTICS
+
+class Statistic final {
+private:
+	const char* m_group;
+	const char* m_description;
+	std::atomic<u64> m_value = 0; // the code generation runs on several threads
+
+	Statistic* m_next; // the list of all the counters
+
+	static Statistic* s_first;
+
+public:
+	Statistic(const char* group, const char* description);
+
+	Statistic& operator++() {
+		m_value.fetch_add(1, std::memory_order_relaxed);
+		return *this;
+	}
+
+	Statistic& operator+=(u64 value) {
+		m_value.fetch_add(value, std::memory_order_relaxed);
+		return *this;
+	}
+
+	u64 getValue() const;
+
+	static void printAll();
+};
+
+#else
+
+class Statistic final {
+public:
+	constexpr Statistic(const char*, const char*) { }
+
+	Statistic& operator++() { return *this; }
+	Statistic& operator+=(u64) { return *this; }
+
+	u64 getValue() const { return 0; }
+
+	static void printAll();
+};
+
+#endif
+
+#define STATISTIC(var, group, description) static Statistic var(group, description)
@@ -0,0 +1,28 @@
+#include "StringInterner.h"
+
+StringInterner g_stringInterner;
+
+StringInterner::StringInterner() {
+	intern("");
+}
+
+u32 StringInterner::intern(std::string_view str) {
+	if (auto it = m_ids.find(str); it != m_ids.end()) {
+		return it->second;
+	}
+
+	u32 id = u32(m_strings.size());
+	const std::string& stored = m_strings.emplace_back(str);
+	m_ids.emplace(std::string_view(stored), id);
+
+	return id;
+}
+
+const std::string& StringInterner::get(u32 id) const {
+	ASSERT(id < m_strings.size(), "no such interned string");
+	return m_strings[id];
+}
+
+u32 StringInterner::size() const {
+	return u32(m_strings.size());
+}
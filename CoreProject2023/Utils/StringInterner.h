@@ -0,0 +1,30 @@
+#pragma once
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include "Defs.h"
+
+/*
+	Keeps a single copy of every string and identifies it by a 32-bit id.
+	Used for the contents of tokens, so that the same identifiers, keywords and
+	operators are not copied again for every token.
+	Id 0 is always the empty string.
+*/
+
+class StringInterner final {
+private:
+	std::deque<std::string> m_strings; // deque keeps the strings in place when growing
+	std::unordered_map<std::string_view, u32> m_ids; // views into m_strings
+
+public:
+	StringInterner();
+
+	// Returns the id of the string, adds the string if it was not met before
+	u32 intern(std::string_view str);
+
+	const std::string& get(u32 id) const;
+	u32 size() const;
+};
+
+extern StringInterner g_stringInterner;
@@ -0,0 +1,174 @@
+#include "TimeTrace.h"
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <llvm/ADT/Any.h>
+#include <llvm/IR/Module.h>
+#include <llvm/IR/Function.h>
+#include <llvm/IR/PassInstrumentation.h>
+#include <llvm/Support/TimeProfiler.h>
+#include <llvm/Support/Error.h>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <unistd.h>
+#include <sys/resource.h>
+#endif
+
+TimeTrace g_timeTrace;
+
+void TimeTrace::enable() {
+	m_isEnabled = true;
+	llvm::timeTraceProfilerInitialize(GRANULARITY, "CoreProject2023");
+}
+
+bool TimeTrace::isEnabled() const {
+	return m_isEnabled;
+}
+
+void TimeTrace::attachThread() {
+	if (m_isEnabled && !llvm::getTimeTraceProfilerInstance()) {
+		llvm::timeTraceProfilerInitialize(GRANULARITY, "CoreProject2023");
+	}
+}
+
+void TimeTrace::detachThread() {
+	if (m_isEnabled && llvm::getTimeTraceProfilerInstance()) {
+		llvm::timeTraceProfilerFinishThread(); // the thread's records are kept until the trace is written
+	}
+}
+
+void TimeTrace::addPhase(const std::string& name, double seconds, u64 startMemory) {
+	u64 endMemory = getMemoryUsage();
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	auto [it, isNew] = m_phases.try_emplace(name);
+	if (isNew) {
+		m_phaseOrder.push_back(name);
+	}
+
+	it->second.seconds += seconds;
+	it->second.count++;
+	it->second.memoryDelta += i64(endMemory) - i64(startMemory);
+	it->second.maxMemory = std::max(it->second.maxMemory, endMemory);
+}
+
+void TimeTrace::write(const std::string& fileName) {
+	if (!m_isEnabled) {
+		return;
+	}
+
+	if (llvm::Error error = llvm::timeTraceProfilerWrite(fileName, fileName)) {
+		std::cout << "cannot write the time trace: " << llvm::toString(std::move(error)) << std::endl;
+	} else {
+		std::cout << "time trace written to " << fileName << std::endl;
+	}
+
+	llvm::timeTraceProfilerCleanup();
+	m_isEnabled = false;
+
+	// The phases run in several threads are summed up, so their time can exceed the wall time
+	std::cout << std::left << std::setw(24) << "Phase" << std::right << std::setw(8) << "Count"
+		<< std::setw(12) << "Time (ms)" << std::setw(16) << "RSS delta (MB)" << std::setw(21) << "Max RSS at end (MB)" << std::endl;
+	for (auto& name : m_phaseOrder) {
+		PhaseStats& stats = m_phases[name];
+		std::cout << std::left << std::setw(24) << name << std::right << std::setw(8) << stats.count
+			<< std::setw(12) << std::fixed << std::setprecision(2) << stats.seconds * 1000
+			<< std::setw(16) << std::setprecision(1) << double(stats.memoryDelta) / (1024 * 1024)
+			<< std::setw(21) << double(stats.maxMemory) / (1024 * 1024) << std::endl;
+	}
+
+	std::cout << "Total peak RSS: " << std::setprecision(1) << double(getPeakMemoryUsage()) / (1024 * 1024) << " MB" << std::endl;
+}
+
+void TimeTrace::registerPassCallbacks(llvm::PassInstrumentationCallbacks& callbacks) {
+	if (!m_isEnabled) {
+		return;
+	}
+
+	auto getIRName = [](llvm::Any IR) -> std::string {
+		if (llvm::any_isa<const llvm::Module*>(IR)) {
+			return llvm::any_cast<const llvm::Module*>(IR)->getName().str();
+		} else if (llvm::any_isa<const llvm::Function*>(IR)) {
+			return llvm::any_cast<const llvm::Function*>(IR)->getName().str();
+		}
+
+		return "";
+	};
+
+	callbacks.registerBeforeNonSkippedPassCallback([getIRName](llvm::StringRef pass, llvm::Any IR) {
+		llvm::timeTraceProfilerBegin(pass, getIRName(IR));
+	});
+
+	callbacks.registerAfterPassCallback([](llvm::StringRef, llvm::Any, const llvm::PreservedAnalyses&) {
+		llvm::timeTraceProfilerEnd();
+	});
+
+	callbacks.registerAfterPassInvalidatedCallback([](llvm::StringRef, const llvm::PreservedAnalyses&) {
+		llvm::timeTraceProfilerEnd();
+	});
+}
+
+u64 TimeTrace::getMemoryUsage() {
+#ifdef _WIN32
+	PROCESS_MEMORY_COUNTERS counters;
+	if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+		return u64(counters.WorkingSetSize);
+	}
+
+	return 0;
+#else
+	// The second number is the resident set size in pages
+	std::ifstream statm("/proc/self/statm");
+	u64 size = 0, resident = 0;
+	if (statm >> size >> resident) {
+		return resident * u64(sysconf(_SC_PAGESIZE));
+	}
+
+	return 0;
+#endif
+}
+
+u64 TimeTrace::getPeakMemoryUsage() {
+#ifdef _WIN32
+	PROCESS_MEMORY_COUNTERS counters;
+	if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+		return u64(counters.PeakWorkingSetSize);
+	}
+
+	return 0;
+#else
+	rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) == 0) {
+		return u64(usage.ru_maxrss) * 1024; // in kilobytes on Linux
+	}
+
+	return 0;
+#endif
+}
+
+TimePhase::TimePhase(std::string name, const std::string& detail)
+	: m_name(std::move(name)), m_start(std::chrono::steady_clock::now()) {
+	if (g_timeTrace.isEnabled()) {
+		m_startMemory = TimeTrace::getMemoryUsage();
+		llvm::timeTraceProfilerBegin(m_name, detail);
+	}
+}
+
+TimePhase::~TimePhase() {
+	if (g_timeTrace.isEnabled()) {
+		llvm::timeTraceProfilerEnd();
+		g_timeTrace.addPhase(m_name, std::chrono::duration<double>(std::chrono::steady_clock::now() - m_start).count(), m_startMemory);
+	}
+}
+
+TimeTraceThread::TimeTraceThread() {
+	g_timeTrace.attachThread();
+}
+
+TimeTraceThread::~TimeTraceThread() {
+	g_timeTrace.detachThread();
+}
@@ -0,0 +1,85 @@
+#pragma once
+#include <map>
+#include <mutex>
+#include <chrono>
+#include <string>
+#include <vector>
+#include "Defs.h"
+
+namespace llvm {
+	class PassInstrumentationCallbacks;
+}
+
+/*
+	The time trace of the compilation (option --time-trace).
+	The phases of the compiler are recorded by LLVM's time trace profiler together with LLVM's own
+	sections (the passes of the optimization pipeline, the code generation of each function), and written
+	as a Chrome trace (open it in chrome://tracing or ui.perfetto.dev).
+	At the end a summary with the total time of each phase and the memory usage (RSS) it added is printed.
+	The phases run on several threads at once share the process' memory, so their memory deltas overlap.
+*/
+
+class TimeTrace final {
+private:
+	struct PhaseStats {
+		double seconds = 0;
+		u64 count = 0;
+		i64 memoryDelta = 0; // in bytes, the sum of the changes of RSS from the start to the end of the phase
+		u64 maxMemory = 0; // in bytes, the largest RSS at the end of the phase
+	};
+
+	bool m_isEnabled = false;
+
+	std::mutex m_mutex;
+	std::map<std::string, PhaseStats> m_phases;
+	std::vector<std::string> m_phaseOrder; // the summary keeps the order in which the phases first happened
+
+public:
+	static constexpr u32 GRANULARITY = 100; // only the sections longer than that (in microseconds) get into the trace
+
+	void enable();
+	bool isEnabled() const;
+
+	// Each thread that records the phases must be attached, the main thread is attached by enable()
+	void attachThread();
+	void detachThread();
+
+	void addPhase(const std::string& name, double seconds, u64 startMemory);
+
+	// Writes the trace and prints the summary
+	void write(const std::string& fileName);
+
+	// Passes of the new pass manager are recorded through its instrumentation
+	void registerPassCallbacks(llvm::PassInstrumentationCallbacks& callbacks);
+
+	// The current and the peak RSS of the process
+	static u64 getMemoryUsage();
+	static u64 getPeakMemoryUsage();
+};
+
+extern TimeTrace g_timeTrace;
+
+// Records a phase of the compilation while in scope
+class TimePhase final {
+private:
+	std::string m_name;
+	std::chrono::steady_clock::time_point m_start;
+	u64 m_startMemory = 0;
+
+public:
+	TimePhase(std::string name, const std::string& detail = "");
+	~TimePhase();
+
+	TimePhase(const TimePhase&) = delete;
+	TimePhase& operator=(const TimePhase&) = delete;
+};
+
+// Attaches the current thread to the time trace while in scope
+class TimeTraceThread final {
+public:
+	TimeTraceThread();
+	~TimeTraceThread();
+
+	TimeTraceThread(const TimeTraceThread&) = delete;
+	TimeTraceThread& operator=(const TimeTraceThread&) = delete;
+};
@@ -0,0 +1,168 @@
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <Lexer/Lexer.h>
+#include <Project/Compiler.h>
+#include <Utils/TimeTrace.h>
+
+/*
+	Standalone benchmarks of the compiler's parts, built separately from the compiler (build_benchmark.cmd).
+	Usage:
+		benchmark lexer [megabytes]
+			Generates a .core source of the given size (8 MB by default) into benchmark.core,
+			tokenizes it several times and prints the best throughput of Lexer::tokenize in MB/s.
+		benchmark ast [functions]
+			Generates a program of the given number of functions (20000 by default) into benchmark_ast.core
+			with the project file benchmark_ast.coreproject, builds it with the time trace and prints the time trace's summary
+			(the time and the memory of parsing and code generation) and the statistics (the bytes of the AST nodes).
+			The same project can be built by another build of the compiler with --time-trace --stats to compare them.
+*/
+
+constexpr int RUNS = 5;
+
+// A part of a module in the style of the standard library, the functions are numbered so that the names would differ
+std::string genLexerSourcePart(u64 index) {
+	std::string id = std::to_string(index);
+	return "# The functions of part " + id + "\n"
+		"def print_" + id + "(const str8 str, i32 count) {\n"
+		"\tfor i32 i = 0; i < count; i += 1 {\n"
+		"\t\tcstdio.fwrite(u8*(str.data), 1, str.size, cstdio.stdout);\n"
+		"\t}\n"
+		"}\n"
+		"\n"
+		"def compute_" + id + "(i64 a, f64 b) f64 {\n"
+		"\tconst i64 mask = 0x7fff'ffffi64;\n"
+		"\tf64 result = f64(a & mask) * 2.5 + b / 0.75;\n"
+		"\tif result >= 1000.0 && a != 0 || b < -1.0 {\n"
+		"\t\tresult -= 42.125;\n"
+		"\t} elif result == 0.0 {\n"
+		"\t\tresult = 1.0;\n"
+		"\t}\n"
+		"\n"
+		"\treturn result;\n"
+		"}\n"
+		"\n"
+		"def newline_" + id + "() {\n"
+		"\tcstdio.putchar(i32('\\n'));\n"
+		"\tprint_" + id + "(\"part " + id + " is done\", 1);\n"
+		"}\n"
+		"\n";
+}
+
+int benchmarkLexer(double megabytes) {
+	const char* fileName = "benchmark.core";
+	{
+		std::ofstream file(fileName, std::ios::binary);
+		u64 size = 0;
+		file << "@set default_imports false\n";
+		for (u64 i = 0; size < u64(megabytes * 1024 * 1024); i++) {
+			std::string part = genLexerSourcePart(i);
+			size += part.size();
+			file << part;
+		}
+	}
+
+	std::ifstream file(fileName, std::ios::binary);
+	std::stringstream stream;
+	stream << file.rdbuf();
+	std::string text = stream.str();
+
+	g_currFilePath = fileName;
+	g_currFileName = "benchmark";
+
+	double bestSeconds = 1e9;
+	size_t tokensCount = 0;
+	for (int i = 0; i < RUNS; i++) {
+		auto start = std::chrono::steady_clock::now();
+		Lexer lexer(text);
+		std::vector<Token> toks = lexer.tokenize();
+		double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+		bestSeconds = std::min(bestSeconds, seconds);
+		tokensCount = toks.size();
+	}
+
+	double size = double(text.size()) / (1024 * 1024);
+	std::cout << "Lexer: " << size << " MB, " << tokensCount << " tokens, best of " << RUNS << ": "
+		<< bestSeconds * 1000 << " ms, " << size / bestSeconds << " MB/s" << std::endl;
+
+	return 0;
+}
+
+// A function with local variables, arithmetic, a branch and a call of the previous function
+std::string genASTFunction(u32 index) {
+	std::string id = std::to_string(index);
+	return "def f_" + id + "(i32 a, i32 b) i32 {\n"
+		"\ti32 x = a * 3 + b;\n"
+		"\ti32 y = (x - 7) * 2 + a * b;\n"
+		"\tif x > y {\n"
+		"\t\tx = x - y;\n"
+		"\t} else {\n"
+		"\t\ty = y + x * 2;\n"
+		"\t}\n"
+		"\n"
+		"\ti32 z = x * y + " + id + ";\n"
+		"\treturn z - " + (index == 0 ? std::string("0") : "f_" + std::to_string(index - 1) + "(x, y)") + ";\n"
+		"}\n"
+		"\n";
+}
+
+int benchmarkAST(u32 functions) {
+	functions = std::max(functions, 1u); // main calls the last function
+	std::string sourcePath = std::filesystem::absolute("benchmark_ast.core").generic_string();
+	std::string projectPath = std::filesystem::absolute("benchmark_ast.coreproject").generic_string();
+	std::string objectPath = std::filesystem::absolute("benchmark_ast.o").generic_string();
+	std::string executablePath = std::filesystem::absolute("benchmark_ast").generic_string();
+
+	{
+		std::ofstream file(sourcePath, std::ios::binary);
+		file << "@set default_imports false\n";
+		for (u32 i = 0; i < functions; i++) {
+			file << genASTFunction(i);
+		}
+
+		file << "def main() i32 {\n\treturn f_" << (functions - 1) << "(1, 2);\n}\n";
+	}
+
+	{
+		std::ofstream file(projectPath, std::ios::binary);
+		file << "{\n"
+			"\t\"name\": \"benchmark_ast\",\n"
+			"\t\"modules\": [ \"" << sourcePath << "\" ],\n"
+			"\t\"opt-level\": 0,\n"
+			"\t\"compilation-mode\": \"program\",\n"
+			"\t\"output\": {\n"
+			"\t\t\"object-data\": [ \"file\", \"" << objectPath << "\" ],\n"
+			"\t\t\"executable-data\": [ \"file\", \"" << executablePath << "\" ]\n"
+			"\t}\n"
+			"}\n";
+	}
+
+	g_timeTrace.enable();
+
+	Project project(projectPath);
+	Compiler compiler(project);
+	compiler.buildProject();
+
+	g_timeTrace.write("benchmark_ast.time-trace.json");
+	compiler.printStatistics();
+
+	quick_exit(0); // so as not to fail due to llvm destructors, as in main.cpp
+}
+
+int main(int argc, char* argv[]) {
+	ErrorManager::init(ErrorManager::CONSOLE);
+
+	std::string benchmark = argc > 1 ? argv[1] : "";
+	if (benchmark == "lexer") {
+		return benchmarkLexer(argc > 2 ? std::stod(argv[2]) : 8);
+	} else if (benchmark == "ast") {
+		return benchmarkAST(argc > 2 ? u32(std::stoul(argv[2])) : 20000);
+	}
+
+	std::cout << "Usage: benchmark lexer [megabytes] | benchmark ast [functions]" << std::endl;
+	return 1;
+}
@@ -0,0 +1,14 @@
+@echo off
+rem Builds benchmark.exe from benchmark.cpp and the compiler's sources apart from main.cpp and experimental.cpp
+setlocal enabledelayedexpansion
+set LLVM=C:\llvm\llvm-project
+set LLVM_LIB=%LLVM%\build\Release\lib
+set SOURCES=
+set LIBS=
+for /r %%f in (*.cpp) do (
+	if /i not "%%~nxf"=="main.cpp" if /i not "%%~nxf"=="experimental.cpp" set SOURCES=!SOURCES! "%%f"
+)
+for /f "delims=" %%l in ('%LLVM%\build\Release\bin\llvm-config.exe --libfiles --system-libs') do set LIBS=!LIBS! %%l
+set LIBS=%LIBS% %LLVM_LIB%\lldCOFF.lib %LLVM_LIB%\lldELF.lib %LLVM_LIB%\lldCommon.lib psapi.lib
+clang++.exe -std=c++20 -O2 -DNDEBUG -D_SILENCE_CXX20_CISO646_REMOVED_WARNING -I. -I%LLVM%\llvm\include -I%LLVM%\lld\include -I%LLVM%\build\include -IC:\nlohmann %SOURCES% %LIBS% -o benchmark.exe
+pause
\ No newline at end of file
@@ -1,16 +1,88 @@
 #include <iostream>
+#include <charconv>
 #include <Project/Compiler.h>
+#include <Utils/ErrorManager.h>
+#include <Utils/TimeTrace.h>
 
 // TODO: refactor operation expressions, arguments' default values
 // Long term TODO: implement optionals, add ct preprocesing
 // Current tasks: templates, internal types, llvm intrinsics, destructors, ranges (for ranges)
 // To test: strings, format strings, str's convertions
 
-int main() {
-	Project project("C:/Users/egor2/source/repos/CoreProject2023/examples/testProject.coreproject");
+int main(int argc, char* argv[]) {
+	std::string projectFile = "C:/Users/egor2/source/repos/CoreProject2023/examples/testProject.coreproject";
+	std::string jobs; // validated after the project is loaded, when errors can be reported
+	bool hasJobs = false;
+	bool isJIT = false;
+	std::string timeTraceFile;
+	bool isStats = false;
+
+	const char* usage = "Usage: CoreProject2023 [project-file] [-j N] [--jit] [--time-trace[=file]] [--stats]";
+
+	// --jit compiles the program in memory and runs it at once, without object files and linking
+	// --time-trace writes the time trace of the compilation (build/<project name>.time-trace.json by default)
+	// --stats prints the counters of the compiler's work (tokens, AST nodes, symbol lookups, types) and the tokens of each module
+	for (int i = 1; i < argc; i++) {
+		std::string arg = argv[i];
+		if (arg == "-j") {
+			jobs = i + 1 < argc ? argv[++i] : "";
+			hasJobs = true;
+		} else if (arg.size() > 2 && arg.starts_with("-j")) {
+			jobs = arg.substr(2);
+			hasJobs = true;
+		} else if (arg == "--jit") {
+			isJIT = true;
+		} else if (arg == "--time-trace") {
+			timeTraceFile = "-";
+		} else if (arg.starts_with("--time-trace=")) {
+			timeTraceFile = arg.substr(13);
+		} else if (arg == "--stats") {
+			isStats = true;
+		} else if (arg.starts_with("-")) {
+			// A mistyped option must not be taken for the project file
+			std::cout << "unknown option " << arg << "\n" << usage << std::endl;
+			return 1;
+		} else {
+			projectFile = arg;
+		}
+	}
+
+	if (timeTraceFile != "") {
+		g_timeTrace.enable();
+	}
+
+	Project project(projectFile);
+	if (hasJobs) {
+		u32 jobsValue = 0;
+		auto [end, errorCode] = std::from_chars(jobs.data(), jobs.data() + jobs.size(), jobsValue);
+		if (jobs.empty() || errorCode != std::errc() || end != jobs.data() + jobs.size()) {
+			ErrorManager::projectSettingsError(ErrorID::E5003_WRONG_SETTING_VALUE, -1, "-j cannot be " + (jobs.empty() ? "empty" : jobs));
+		}
+
+		project.getSettings().jobs = jobsValue;
+	}
+
+	if (timeTraceFile == "-") {
+		timeTraceFile = "build/" + project.getSettings().projectName + ".time-trace.json";
+	}
+
 	Compiler compiler(project);
+	if (isJIT) {
+		i32 exitCode = compiler.runProjectJIT();
+		g_timeTrace.write(timeTraceFile);
+		if (isStats) {
+			compiler.printStatistics();
+		}
+
+		quick_exit(exitCode);
+	}
+
 	compiler.buildProject();
 	compiler.linkProject();
+	g_timeTrace.write(timeTraceFile);
+	if (isStats) {
+		compiler.printStatistics();
+	}
 
 	if (project.getSettings().compilationMode == CompilationMode::Program) {
 		char ch;